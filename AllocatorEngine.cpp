@@ -0,0 +1,134 @@
+#include "AllocatorEngine.h"
+
+//______________________________________________________________________________Size Ordered Engines_______________________________________________________________________________
+//The tree holds (size, offset) pairs, the capacity and arena are not needed to order holes by size
+void SizeOrderedEngine::Reset(unsigned int capacity, uint64_t* arena) {
+	holesBySize.clear();
+}
+
+void SizeOrderedEngine::InsertHole(unsigned int offset, unsigned int size) {
+	holesBySize.insert(std::make_pair(size, offset));
+}
+
+void SizeOrderedEngine::EraseHole(unsigned int offset, unsigned int size) {
+	holesBySize.erase(std::make_pair(size, offset));
+}
+
+unsigned int SizeOrderedEngine::GetLargestHole() {
+	return holesBySize.empty() ? 0 : holesBySize.rbegin()->first;
+}
+
+//______________________________________________________________________________Max Hole Tree Engines_______________________________________________________________________________
+//The number of leaves is rounded up to a power of 2 so every internal node has two children
+void MaxHoleTreeEngine::Reset(unsigned int capacity, uint64_t* arena) {
+	leaves = 1;
+	while (leaves < capacity) {
+		leaves *= 2;
+	}
+	tree.assign(leaves * 2, 0);
+}
+
+void MaxHoleTreeEngine::InsertHole(unsigned int offset, unsigned int size) {
+	SetLeaf(offset, size);
+}
+
+void MaxHoleTreeEngine::EraseHole(unsigned int offset, unsigned int size) {
+	SetLeaf(offset, 0);
+}
+
+//The root holds the largest hole of the whole tree
+unsigned int MaxHoleTreeEngine::GetLargestHole() {
+	return tree.empty() ? 0 : tree[1];
+}
+
+//Sets the leaf for offset, then walks up to the root updating the largest hole of each subtree on the way
+void MaxHoleTreeEngine::SetLeaf(unsigned int offset, unsigned int size) {
+	uint64_t node = leaves + offset;
+	tree[node] = size;
+	node /= 2;
+	while (node >= 1) {
+		unsigned int largest = tree[2 * node] > tree[(2 * node) + 1] ? tree[2 * node] : tree[(2 * node) + 1];
+		if (tree[node] == largest) {
+			break;
+		}
+		tree[node] = largest;
+		node /= 2;
+	}
+}
+
+//Returns the lowest offset at or after offset whose hole fits, or -1 if there is none
+int64_t MaxHoleTreeEngine::FindFirstFrom(unsigned int offset, unsigned int sizeInWords) {
+	//A hole always has at least 1 word, so asking for 0 words finds the first hole
+	if (sizeInWords == 0) {
+		sizeInWords = 1;
+	}
+	return FindFirstFrom(1, 0, leaves, offset, sizeInWords);
+}
+
+//Searches the subtree of node, which covers the offsets [low, high). Subtrees that end before offset or have no hole that fits are skipped,
+//and a subtree fully after offset with a hole that fits always holds the answer, so only O(log n) nodes are visited
+int64_t MaxHoleTreeEngine::FindFirstFrom(uint64_t node, uint64_t low, uint64_t high, unsigned int offset, unsigned int sizeInWords) {
+	if (high <= offset || tree[node] < sizeInWords) {
+		return -1;
+	}
+	if (node >= leaves) {
+		return (int64_t)low;
+	}
+	uint64_t middle = low + ((high - low) / 2);
+	int64_t found = FindFirstFrom(node * 2, low, middle, offset, sizeInWords);
+	if (found == -1) {
+		found = FindFirstFrom((node * 2) + 1, middle, high, offset, sizeInWords);
+	}
+	return found;
+}
+
+//Returns the highest offset before offset which starts a hole, or -1 if there is none
+int64_t MaxHoleTreeEngine::FindLastBefore(unsigned int offset) {
+	return FindLastBefore(1, 0, leaves, offset);
+}
+
+//Mirror of FindFirstFrom, searching the right subtree first for any hole at all
+int64_t MaxHoleTreeEngine::FindLastBefore(uint64_t node, uint64_t low, uint64_t high, unsigned int offset) {
+	if (low >= offset || tree[node] == 0) {
+		return -1;
+	}
+	if (node >= leaves) {
+		return (int64_t)low;
+	}
+	uint64_t middle = low + ((high - low) / 2);
+	int64_t found = FindLastBefore((node * 2) + 1, middle, high, offset);
+	if (found == -1) {
+		found = FindLastBefore(node * 2, low, middle, offset);
+	}
+	return found;
+}
+
+int64_t FirstFitEngine::FindHole(unsigned int sizeInWords) {
+	return FindFirstFrom(0, sizeInWords);
+}
+
+void NextFitEngine::Reset(unsigned int capacity, uint64_t* arena) {
+	MaxHoleTreeEngine::Reset(capacity, arena);
+	cursor = 0;
+}
+
+int64_t NextFitEngine::FindHole(unsigned int sizeInWords) {
+	//The hole holding the cursor starts before it if it was compacted with holes to its left, so it is checked first
+	int64_t offset = -1;
+	int64_t holding = FindLastBefore(cursor);
+	if (holding != -1 && holding + tree[leaves + holding] > cursor && tree[leaves + holding] >= sizeInWords) {
+		offset = holding;
+	}
+	//Otherwise search the holes after the cursor, then wrap around to the start of the heap
+	if (offset == -1) {
+		offset = FindFirstFrom(cursor, sizeInWords);
+	}
+	if (offset == -1) {
+		offset = FindFirstFrom(0, sizeInWords);
+	}
+	//The next search resumes where this allocation ends
+	if (offset != -1) {
+		cursor = offset + sizeInWords;
+	}
+	return offset;
+}
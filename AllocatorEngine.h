@@ -0,0 +1,112 @@
+#pragma once
+#include <set>
+#include <vector>
+#include <utility>
+#include <stdint.h>
+
+//An allocator engine keeps its own index of the holes in a memory list and searches that index instead of scanning the hole list
+//The memory list reports every hole it gains or loses to its engine, so the index never has to be rebuilt
+class AllocatorEngine {
+public:
+	virtual ~AllocatorEngine() {}
+
+	//___________Keeping the Index Up To Date____________
+	//Reset is called when the engine is attached to a memory list, before the list reports the holes it already has
+	virtual void Reset(unsigned int capacity, uint64_t* arena) = 0;
+	virtual void InsertHole(unsigned int offset, unsigned int size) = 0;
+	virtual void EraseHole(unsigned int offset, unsigned int size) = 0;
+
+	//___________Searching the Index____________
+	//Returns the offset of the hole to allocate sizeInWords from, or -1 if no hole fits
+	virtual int64_t FindHole(unsigned int sizeInWords) = 0;
+	//Returns the size of the largest hole, or 0 if there are none. Only read for statistics, never while allocating
+	virtual unsigned int GetLargestHole() = 0;
+};
+
+//Keeps the holes in a balanced tree ordered by (size, offset), so fits by size are found in O(log n)
+class SizeOrderedEngine : public AllocatorEngine {
+public:
+	void Reset(unsigned int capacity, uint64_t* arena) override;
+	void InsertHole(unsigned int offset, unsigned int size) override;
+	void EraseHole(unsigned int offset, unsigned int size) override;
+	unsigned int GetLargestHole() override;
+
+protected:
+	std::set<std::pair<unsigned int, unsigned int>> holesBySize;
+};
+
+//Picks the same hole as bestFit: the smallest hole that fits, the lowest offset among equal sizes
+class BestFitEngine : public SizeOrderedEngine {
+public:
+	int64_t FindHole(unsigned int sizeInWords) override;
+};
+
+//Picks the same hole as worstFit: the largest hole, the lowest offset among equal sizes
+class WorstFitEngine : public SizeOrderedEngine {
+public:
+	int64_t FindHole(unsigned int sizeInWords) override;
+};
+
+//Keeps the size of the hole starting at each offset in the leaves of a segment tree, where every node stores the largest hole in its subtree
+//This finds the lowest addressed hole that fits in O(log n)
+class MaxHoleTreeEngine : public AllocatorEngine {
+public:
+	void Reset(unsigned int capacity, uint64_t* arena) override;
+	void InsertHole(unsigned int offset, unsigned int size) override;
+	void EraseHole(unsigned int offset, unsigned int size) override;
+	unsigned int GetLargestHole() override;
+
+protected:
+	void SetLeaf(unsigned int offset, unsigned int size);
+	int64_t FindFirstFrom(unsigned int offset, unsigned int sizeInWords);
+	int64_t FindLastBefore(unsigned int offset);
+
+private:
+	int64_t FindFirstFrom(uint64_t node, uint64_t low, uint64_t high, unsigned int offset, unsigned int sizeInWords);
+	int64_t FindLastBefore(uint64_t node, uint64_t low, uint64_t high, unsigned int offset);
+
+protected:
+	//tree[1] is the root, the children of node i are 2i and 2i+1, and the leaf for offset i is tree[leaves + i]
+	std::vector<unsigned int> tree;
+	uint64_t leaves;
+};
+
+//Picks the same hole as firstFit: the hole with the lowest offset that fits
+class FirstFitEngine : public MaxHoleTreeEngine {
+public:
+	int64_t FindHole(unsigned int sizeInWords) override;
+};
+
+//Next fit resumes the search where the last allocation ended instead of at offset 0, wrapping around to the start of the heap
+//The cursor is a word offset, so it stays meaningful however the blocks around it are split and compacted
+class NextFitEngine : public MaxHoleTreeEngine {
+public:
+	void Reset(unsigned int capacity, uint64_t* arena) override;
+	int64_t FindHole(unsigned int sizeInWords) override;
+
+private:
+	unsigned int cursor;
+};
+
+//The searches are defined here so a PolicyMemoryManager, which calls them without virtual dispatch, can inline them
+
+//The first pair not less than (sizeInWords, 0) is the smallest hole that fits, at the lowest offset among holes of its size
+inline int64_t BestFitEngine::FindHole(unsigned int sizeInWords) {
+	std::set<std::pair<unsigned int, unsigned int>>::iterator it = holesBySize.lower_bound(std::make_pair(sizeInWords, 0u));
+	if (it == holesBySize.end()) {
+		return -1;
+	}
+	return (int64_t)it->second;
+}
+
+//The last pair is the largest hole but the highest offset of its size, so look up the first hole of that size to match worstFit
+inline int64_t WorstFitEngine::FindHole(unsigned int sizeInWords) {
+	if (holesBySize.empty()) {
+		return -1;
+	}
+	unsigned int maxSize = holesBySize.rbegin()->first;
+	if (maxSize < sizeInWords) {
+		return -1;
+	}
+	return (int64_t)holesBySize.lower_bound(std::make_pair(maxSize, 0u))->second;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//Index of the lowest and highest set bit of a non-zero word, each a single instruction on the compilers we build with
+inline unsigned int LowestSetBit(uint64_t bits) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return index;
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
+
+inline unsigned int HighestSetBit(uint64_t bits) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, bits);
+	return index;
+#else
+	return 63 - __builtin_clzll(bits);
+#endif
+}
+
+//Sets or clears the bits [offset, offset + size) of a packed bitmap, a whole 64-bit element at a time for the elements fully inside the range
+inline void SetBitRange(std::vector<uint64_t>& bits, uint64_t offset, uint64_t size, bool value) {
+	uint64_t first = offset;
+	uint64_t last = offset + size;
+	while (first < last) {
+		uint64_t bit = first % 64;
+		uint64_t count = 64 - bit < last - first ? 64 - bit : last - first;
+		uint64_t mask = count == 64 ? ~0ull : ((1ull << count) - 1) << bit;
+		if (value) {
+			bits[first / 64] |= mask;
+		}
+		else {
+			bits[first / 64] &= ~mask;
+		}
+		first += count;
+	}
+}
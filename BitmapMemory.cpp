@@ -0,0 +1,252 @@
+#include "BitmapMemory.h"
+#include "BitOps.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+//______________________________________________________________________________________________________Bitmap Memory______________________________________________________________________________________________________
+//Default constructor, the arena and bitmaps are created by Initialize
+BitmapMemory::BitmapMemory() {
+	arena = nullptr;
+	listData = nullptr;
+	memory_capacity = 0;
+}
+
+BitmapMemory::~BitmapMemory() {
+	Clear();
+}
+
+//Creates the arena with every word free, marking the bits past the capacity as allocated
+void BitmapMemory::Initialize(unsigned int capacity) {
+	Clear();
+	if (capacity == 0) {
+		return;
+	}
+	memory_capacity = capacity;
+	arena = new uint64_t[capacity];
+	uint64_t elements = ((uint64_t)capacity + 63) / 64;
+	occupied.assign(elements, 0);
+	starts.assign(elements, 0);
+	SetBitRange(occupied, capacity, (elements * 64) - capacity, true);
+}
+
+//Deletes the arena and both bitmaps
+void BitmapMemory::Clear() {
+	if (arena != nullptr) {
+		delete[] arena;
+		arena = nullptr;
+	}
+	if (listData != nullptr) {
+		delete[] listData;
+		listData = nullptr;
+	}
+	memory_capacity = 0;
+	occupied.clear();
+	starts.clear();
+}
+
+//Allocates the first run of sizeInWords free words, marking the words as allocated and the first word as the start of an allocation
+uint64_t* BitmapMemory::Allocate(unsigned int sizeInWords) {
+	if (arena == nullptr || sizeInWords > memory_capacity) {
+		return nullptr;
+	}
+	if (sizeInWords == 0) {
+		sizeInWords = 1;
+	}
+	int64_t offset = FindFreeRun(sizeInWords);
+	if (offset == -1) {
+		return nullptr;
+	}
+	SetBitRange(occupied, offset, sizeInWords, true);
+	starts[offset / 64] |= (1ull << (offset % 64));
+	return arena + offset;
+}
+
+//Clears the words of the allocation starting at data. Pointers that do not start an allocation are ignored
+void BitmapMemory::Free(uint64_t* data) {
+	if (arena == nullptr) {
+		return;
+	}
+	uintptr_t address = reinterpret_cast<uintptr_t>(data);
+	uintptr_t base = reinterpret_cast<uintptr_t>(arena);
+	if (address < base || (address - base) % sizeof(uint64_t) != 0 || (address - base) / sizeof(uint64_t) >= memory_capacity) {
+		return;
+	}
+	uint64_t offset = (address - base) / sizeof(uint64_t);
+	if ((starts[offset / 64] & (1ull << (offset % 64))) == 0) {
+		return;
+	}
+	starts[offset / 64] &= ~(1ull << (offset % 64));
+	uint64_t end = FindNextBoundary(offset + 1);
+	SetBitRange(occupied, offset, end - offset, false);
+}
+
+//Returns the lowest offset of sizeInWords free words in a row, or -1 if there is none
+//Each element is handled whole when it is all free or all allocated, otherwise its runs of free bits are stepped through with count-trailing-zeros
+int64_t BitmapMemory::FindFreeRun(unsigned int sizeInWords) {
+	uint64_t runStart = 0;
+	uint64_t runLength = 0;
+	uint64_t elements = occupied.size();
+	uint64_t ii = 0;
+	while (ii < elements) {
+#ifdef __AVX2__
+		//Outside of a run, 4 elements that are all allocated are skipped with one compare
+		if (runLength == 0 && ii + 4 <= elements) {
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&occupied[ii]));
+			if (_mm256_testc_si256(block, _mm256_set1_epi64x(-1))) {
+				ii += 4;
+				continue;
+			}
+		}
+#endif
+		uint64_t free = ~occupied[ii];
+		if (free == 0) {
+			runLength = 0;
+		}
+		else if (free == ~0ull) {
+			if (runLength == 0) {
+				runStart = ii * 64;
+			}
+			runLength += 64;
+			if (runLength >= sizeInWords) {
+				return (int64_t)runStart;
+			}
+		}
+		else {
+			unsigned int bit = 0;
+			while (bit < 64) {
+				uint64_t rest = free >> bit;
+				if (rest == 0) {
+					runLength = 0;
+					break;
+				}
+				if ((rest & 1) == 0) {
+					//Skip the allocated bits up to the next free bit, which ends any run in progress
+					runLength = 0;
+					bit += LowestSetBit(rest);
+					continue;
+				}
+				//Count the free bits starting at bit, which continue any run in progress
+				unsigned int count = ~rest == 0 ? 64 - bit : LowestSetBit(~rest);
+				if (count > 64 - bit) {
+					count = 64 - bit;
+				}
+				if (runLength == 0) {
+					runStart = (ii * 64) + bit;
+				}
+				runLength += count;
+				if (runLength >= sizeInWords) {
+					return (int64_t)runStart;
+				}
+				bit += count;
+			}
+		}
+		ii += 1;
+	}
+	return -1;
+}
+
+//Returns the first offset at or after offset that is free or starts an allocation, which is where the allocation before it ends
+uint64_t BitmapMemory::FindNextBoundary(uint64_t offset) {
+	uint64_t elements = occupied.size();
+	uint64_t ii = offset / 64;
+	if (ii >= elements) {
+		return memory_capacity;
+	}
+	uint64_t boundary = (starts[ii] | ~occupied[ii]) & (~0ull << (offset % 64));
+	while (boundary == 0) {
+		ii += 1;
+		if (ii >= elements) {
+			return memory_capacity;
+		}
+		boundary = starts[ii] | ~occupied[ii];
+	}
+	//The padding bits past the capacity are set in occupied, so an allocation that reaches the capacity ends there
+	uint64_t boundaryOffset = (ii * 64) + LowestSetBit(boundary);
+	return boundaryOffset < memory_capacity ? boundaryOffset : memory_capacity;
+}
+
+//Walks the runs of free bits in address order
+void BitmapMemory::FindFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v) {
+	uint64_t offset = 0;
+	while (offset < memory_capacity) {
+		//Find the next free word, then the next allocated word after it
+		uint64_t ii = offset / 64;
+		uint64_t free = ~occupied[ii] & (~0ull << (offset % 64));
+		while (free == 0 && ii + 1 < occupied.size()) {
+			ii += 1;
+			free = ~occupied[ii];
+		}
+		if (free == 0) {
+			return;
+		}
+		uint64_t holeStart = (ii * 64) + LowestSetBit(free);
+		uint64_t used = occupied[ii] & (~0ull << (holeStart % 64));
+		while (used == 0 && ii + 1 < occupied.size()) {
+			ii += 1;
+			used = occupied[ii];
+		}
+		//A hole that reaches the end of a capacity that is a multiple of 64 has no allocated bit after it
+		uint64_t holeEnd = used == 0 ? memory_capacity : (ii * 64) + LowestSetBit(used);
+		v.push_back(std::make_pair((unsigned int)holeStart, (unsigned int)(holeEnd - holeStart)));
+		offset = holeEnd;
+	}
+}
+
+void BitmapMemory::BitRepresentation(std::vector<int>& v) {
+	for (uint64_t ii = 0; ii < memory_capacity; ii += 1) {
+		v.push_back((occupied[ii / 64] >> (ii % 64)) & 1);
+	}
+}
+
+//Collects the data of every allocated word in address order
+uint64_t* BitmapMemory::FindFilledBlocks() {
+	std::vector<uint64_t> v;
+	for (uint64_t ii = 0; ii < memory_capacity; ii += 1) {
+		if ((occupied[ii / 64] >> (ii % 64)) & 1) {
+			v.push_back(arena[ii]);
+		}
+	}
+	if (listData != nullptr) {
+		delete[] listData;
+	}
+	listData = new uint64_t[v.size()];
+	for (unsigned int ii = 0; ii < v.size(); ii += 1) {
+		listData[ii] = v.at(ii);
+	}
+	return listData;
+}
+
+const std::vector<uint64_t>* BitmapMemory::GetPackedBitmap() {
+	return &occupied;
+}
+
+unsigned int BitmapMemory::GetCapacity() {
+	return memory_capacity;
+}
+
+uint64_t* BitmapMemory::GetArena() {
+	return arena;
+}
+
+//Allocations are exactly the words requested
+unsigned long long BitmapMemory::GetInternalFragmentation() {
+	return 0;
+}
+
+//An allocation runs from its start bit to the next start bit or free word
+unsigned int BitmapMemory::GetBlockSize(uint64_t* data) {
+	if (arena == nullptr) {
+		return 0;
+	}
+	uintptr_t address = reinterpret_cast<uintptr_t>(data);
+	uintptr_t base = reinterpret_cast<uintptr_t>(arena);
+	if (address < base || (address - base) % sizeof(uint64_t) != 0 || (address - base) / sizeof(uint64_t) >= memory_capacity) {
+		return 0;
+	}
+	uint64_t offset = (address - base) / sizeof(uint64_t);
+	if ((starts[offset / 64] & (1ull << (offset % 64))) == 0) {
+		return 0;
+	}
+	return (unsigned int)(FindNextBoundary(offset + 1) - offset);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "MemoryBackend.h"
+
+//A backend whose only record of the heap is two packed bitmaps: one bit per word that is 1 if the word is allocated, and one bit per word that is 1
+//if an allocation starts there. An allocation runs from its start bit to the next start bit or free word, so no block list is needed
+//Holes are found a 64-bit element at a time with count-trailing-zeros, and with AVX2 fully allocated stretches are skipped 256 words at a time
+class BitmapMemory : public MemoryBackend {
+public:
+	//___________Constructors and Destructors______________
+	BitmapMemory();
+	~BitmapMemory();
+	void Initialize(unsigned int capacity) override;
+	void Clear() override;
+
+	//___________Allocating and Freeing_____________
+	uint64_t* Allocate(unsigned int sizeInWords) override;
+	void Free(uint64_t* data) override;
+
+	//____________Representations of the Backend____________
+	void FindFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v) override;
+	void BitRepresentation(std::vector<int>& v) override;
+	uint64_t* FindFilledBlocks() override;
+	const std::vector<uint64_t>* GetPackedBitmap() override;
+
+	//____________Getters_____________
+	unsigned int GetCapacity() override;
+	uint64_t* GetArena() override;
+	unsigned long long GetInternalFragmentation() override;
+	unsigned int GetBlockSize(uint64_t* data) override;
+
+private:
+	int64_t FindFreeRun(unsigned int sizeInWords);
+	uint64_t FindNextBoundary(uint64_t offset);
+
+	uint64_t* arena;
+	uint64_t* listData;
+	unsigned int memory_capacity;
+	//The bits past the capacity in the last element of occupied are set, so they are never found as free
+	std::vector<uint64_t> occupied;
+	std::vector<uint64_t> starts;
+};
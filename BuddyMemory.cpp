@@ -0,0 +1,246 @@
+#include "BuddyMemory.h"
+#include "BitOps.h"
+
+//______________________________________________________________________________________________________Buddy Memory______________________________________________________________________________________________________
+//Default constructor, the arena is created by Initialize
+BuddyMemory::BuddyMemory() {
+	arena = nullptr;
+	listData = nullptr;
+	memory_capacity = 0;
+	freeOrders = 0;
+	internalFragmentation = 0;
+	for (unsigned int ii = 0; ii < MAX_ORDERS; ii += 1) {
+		freeHeads[ii] = NONE;
+	}
+}
+
+BuddyMemory::~BuddyMemory() {
+	Clear();
+}
+
+//Creates the arena and covers it with free blocks, largest first, so every block is aligned to its size
+void BuddyMemory::Initialize(unsigned int capacity) {
+	Clear();
+	if (capacity == 0) {
+		return;
+	}
+	memory_capacity = capacity;
+	arena = new uint64_t[capacity];
+	blockInfo.assign(capacity, 0);
+
+	unsigned int offset = 0;
+	while (offset < capacity) {
+		unsigned int order = HighestSetBit(capacity - offset);
+		PushFree(offset, order);
+		offset += (1u << order);
+	}
+}
+
+//Deletes the arena and empties every free list
+void BuddyMemory::Clear() {
+	if (arena != nullptr) {
+		delete[] arena;
+		arena = nullptr;
+	}
+	if (listData != nullptr) {
+		delete[] listData;
+		listData = nullptr;
+	}
+	memory_capacity = 0;
+	blockInfo.clear();
+	requestedWords.clear();
+	internalFragmentation = 0;
+	freeOrders = 0;
+	for (unsigned int ii = 0; ii < MAX_ORDERS; ii += 1) {
+		freeHeads[ii] = NONE;
+	}
+}
+
+//Rounds the size up to a power of 2, takes a free block of the smallest order at least that large, and splits it in halves
+//until it is the order needed. Each split puts the right half (the buddy) on the free list one order down
+uint64_t* BuddyMemory::Allocate(unsigned int sizeInWords) {
+	if (arena == nullptr || sizeInWords > memory_capacity) {
+		return nullptr;
+	}
+	if (sizeInWords == 0) {
+		sizeInWords = 1;
+	}
+	unsigned int order = HighestSetBit(sizeInWords);
+	if ((1ull << order) < sizeInWords) {
+		order += 1;
+	}
+	if (order >= MAX_ORDERS) {
+		return nullptr;
+	}
+
+	//The lowest set bit at or above order is the smallest order with a free block
+	uint32_t candidates = freeOrders & (0xFFFFFFFFu << order);
+	if (candidates == 0) {
+		return nullptr;
+	}
+	unsigned int currentOrder = LowestSetBit(candidates);
+	unsigned int offset = freeHeads[currentOrder];
+	RemoveFree(offset, currentOrder);
+	while (currentOrder > order) {
+		currentOrder -= 1;
+		PushFree(offset + (1u << currentOrder), currentOrder);
+	}
+
+	blockInfo[offset] = (uint8_t)((order + 1) | USED);
+	requestedWords[offset] = sizeInWords;
+	internalFragmentation += (1ull << order) - sizeInWords;
+	return arena + offset;
+}
+
+//Merges the block with its buddy while the buddy is a free block of the same order, then puts the merged block on its free list
+void BuddyMemory::Free(uint64_t* data) {
+	if (arena == nullptr) {
+		return;
+	}
+	uintptr_t address = reinterpret_cast<uintptr_t>(data);
+	uintptr_t base = reinterpret_cast<uintptr_t>(arena);
+	if (address < base || (address - base) % sizeof(uint64_t) != 0 || (address - base) / sizeof(uint64_t) >= memory_capacity) {
+		return;
+	}
+	unsigned int offset = (unsigned int)((address - base) / sizeof(uint64_t));
+	if ((blockInfo[offset] & USED) == 0) {
+		return;
+	}
+	unsigned int order = (blockInfo[offset] & ~USED) - 1;
+	blockInfo[offset] = 0;
+
+	std::unordered_map<unsigned int, unsigned int>::iterator requested = requestedWords.find(offset);
+	internalFragmentation -= (1ull << order) - requested->second;
+	requestedWords.erase(requested);
+
+	while (order + 1 < MAX_ORDERS) {
+		unsigned int buddy = offset ^ (1u << order);
+		//The buddy of a block at the end of a capacity that is not a power of 2 may not exist
+		if (buddy >= memory_capacity || blockInfo[buddy] != order + 1) {
+			break;
+		}
+		RemoveFree(buddy, order);
+		blockInfo[buddy] = 0;
+		offset = offset < buddy ? offset : buddy;
+		order += 1;
+	}
+	PushFree(offset, order);
+}
+
+//Walks the blocks in address order, each block starts where the previous one ends
+void BuddyMemory::FindFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v) {
+	unsigned int offset = 0;
+	while (offset < memory_capacity) {
+		unsigned int size = 1u << ((blockInfo[offset] & ~USED) - 1);
+		if ((blockInfo[offset] & USED) == 0) {
+			v.push_back(std::make_pair(offset, size));
+		}
+		offset += size;
+	}
+}
+
+//Allocated blocks are 1s for their whole size, including the words beyond what was requested
+void BuddyMemory::BitRepresentation(std::vector<int>& v) {
+	unsigned int offset = 0;
+	while (offset < memory_capacity) {
+		unsigned int size = 1u << ((blockInfo[offset] & ~USED) - 1);
+		int bit = (blockInfo[offset] & USED) != 0 ? 1 : 0;
+		for (unsigned int ii = 0; ii < size; ii += 1) {
+			v.push_back(bit);
+		}
+		offset += size;
+	}
+}
+
+//Collects the requested words of every allocated block in address order
+uint64_t* BuddyMemory::FindFilledBlocks() {
+	std::vector<uint64_t> v;
+	unsigned int offset = 0;
+	while (offset < memory_capacity) {
+		unsigned int size = 1u << ((blockInfo[offset] & ~USED) - 1);
+		if ((blockInfo[offset] & USED) != 0) {
+			unsigned int requested = requestedWords[offset];
+			for (unsigned int ii = 0; ii < requested; ii += 1) {
+				v.push_back(arena[offset + ii]);
+			}
+		}
+		offset += size;
+	}
+	if (listData != nullptr) {
+		delete[] listData;
+	}
+	listData = new uint64_t[v.size()];
+	for (unsigned int ii = 0; ii < v.size(); ii += 1) {
+		listData[ii] = v.at(ii);
+	}
+	return listData;
+}
+
+unsigned int BuddyMemory::GetCapacity() {
+	return memory_capacity;
+}
+
+uint64_t* BuddyMemory::GetArena() {
+	return arena;
+}
+
+unsigned long long BuddyMemory::GetInternalFragmentation() {
+	return internalFragmentation;
+}
+
+//The words requested for the block, the rest of its power of 2 is internal fragmentation
+unsigned int BuddyMemory::GetBlockSize(uint64_t* data) {
+	if (arena == nullptr) {
+		return 0;
+	}
+	uintptr_t address = reinterpret_cast<uintptr_t>(data);
+	uintptr_t base = reinterpret_cast<uintptr_t>(arena);
+	if (address < base || (address - base) % sizeof(uint64_t) != 0 || (address - base) / sizeof(uint64_t) >= memory_capacity) {
+		return 0;
+	}
+	std::unordered_map<unsigned int, unsigned int>::iterator requested = requestedWords.find((unsigned int)((address - base) / sizeof(uint64_t)));
+	return requested == requestedWords.end() ? 0 : requested->second;
+}
+
+//Pushes the block on the front of the free list for its order
+void BuddyMemory::PushFree(unsigned int offset, unsigned int order) {
+	unsigned int head = freeHeads[order];
+	SetLinks(offset, NONE, head);
+	if (head != NONE) {
+		SetLinks(head, offset, GetNext(head));
+	}
+	freeHeads[order] = offset;
+	freeOrders |= (1u << order);
+	blockInfo[offset] = (uint8_t)(order + 1);
+}
+
+//Unlinks the block from the free list for its order
+void BuddyMemory::RemoveFree(unsigned int offset, unsigned int order) {
+	unsigned int prev = GetPrev(offset);
+	unsigned int next = GetNext(offset);
+	if (prev != NONE) {
+		SetLinks(prev, GetPrev(prev), next);
+	}
+	else {
+		freeHeads[order] = next;
+	}
+	if (next != NONE) {
+		SetLinks(next, prev, GetNext(next));
+	}
+	if (freeHeads[order] == NONE) {
+		freeOrders &= ~(1u << order);
+	}
+}
+
+//The first word of a free block holds the offset of the previous free block of its order in the high 32 bits and the next in the low 32 bits
+unsigned int BuddyMemory::GetNext(unsigned int offset) {
+	return (unsigned int)(arena[offset] & 0xFFFFFFFF);
+}
+
+unsigned int BuddyMemory::GetPrev(unsigned int offset) {
+	return (unsigned int)(arena[offset] >> 32);
+}
+
+void BuddyMemory::SetLinks(unsigned int offset, unsigned int prev, unsigned int next) {
+	arena[offset] = ((uint64_t)prev << 32) | next;
+}
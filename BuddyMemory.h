@@ -0,0 +1,55 @@
+#pragma once
+#include <unordered_map>
+#include "MemoryBackend.h"
+
+//Binary buddy system: every block is 2^order words and starts at an offset aligned to its size, so a block's buddy is found by XOR-ing its offset with its size
+//Allocating splits a larger free block in halves until it has the order needed, freeing merges a block with its buddy for as long as the buddy is free
+//A capacity that is not a power of 2 is covered by the largest aligned powers of 2 that fit, which never merge with each other
+class BuddyMemory : public MemoryBackend {
+public:
+	//___________Constructors and Destructors______________
+	BuddyMemory();
+	~BuddyMemory();
+	void Initialize(unsigned int capacity) override;
+	void Clear() override;
+
+	//___________Allocating and Freeing_____________
+	uint64_t* Allocate(unsigned int sizeInWords) override;
+	void Free(uint64_t* data) override;
+
+	//____________Representations of the Backend____________
+	void FindFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v) override;
+	void BitRepresentation(std::vector<int>& v) override;
+	uint64_t* FindFilledBlocks() override;
+
+	//____________Getters_____________
+	unsigned int GetCapacity() override;
+	uint64_t* GetArena() override;
+	unsigned long long GetInternalFragmentation() override;
+	unsigned int GetBlockSize(uint64_t* data) override;
+
+	static const unsigned int MAX_ORDERS = 32;
+
+private:
+	//___________Per Order Free Lists_____________
+	void PushFree(unsigned int offset, unsigned int order);
+	void RemoveFree(unsigned int offset, unsigned int order);
+	unsigned int GetNext(unsigned int offset);
+	unsigned int GetPrev(unsigned int offset);
+	void SetLinks(unsigned int offset, unsigned int prev, unsigned int next);
+
+	//blockInfo[offset] is 0 if no block starts at offset, otherwise (order + 1) with the USED bit set for allocated blocks
+	static const uint8_t USED = 0x80;
+	static const unsigned int NONE = 0xFFFFFFFF;
+
+	uint64_t* arena;
+	uint64_t* listData;
+	unsigned int memory_capacity;
+	std::vector<uint8_t> blockInfo;
+	//The free blocks of each order are a doubly linked list through the first word of each block, and bit i of freeOrders is set if order i has free blocks
+	unsigned int freeHeads[MAX_ORDERS];
+	uint32_t freeOrders;
+	//Words requested for each allocated block, so the unused tail of each block can be reported
+	std::unordered_map<unsigned int, unsigned int> requestedWords;
+	unsigned long long internalFragmentation;
+};
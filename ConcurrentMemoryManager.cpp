@@ -0,0 +1,170 @@
+#include "ConcurrentMemoryManager.h"
+
+//A thread's caches for every manager it has used. When the thread exits, the caches of managers that are still alive give their blocks back
+struct ThreadCacheList {
+	std::vector<ConcurrentMemoryManager::ThreadCache*> caches;
+
+	~ThreadCacheList() {
+		std::lock_guard<std::mutex> registry(ConcurrentMemoryManager::RegistryLock());
+		for (size_t ii = 0; ii < caches.size(); ii += 1) {
+			ConcurrentMemoryManager* owner = caches[ii]->owner.load();
+			if (owner != nullptr) {
+				for (unsigned int sizeClass = 0; sizeClass < ConcurrentMemoryManager::SIZE_CLASSES; sizeClass += 1) {
+					owner->ReleaseBlocks(caches[ii], sizeClass, caches[ii]->bins[sizeClass].size());
+				}
+				std::vector<ConcurrentMemoryManager::ThreadCache*>& registered = owner->caches;
+				for (size_t jj = 0; jj < registered.size(); jj += 1) {
+					if (registered[jj] == caches[ii]) {
+						registered.erase(registered.begin() + jj);
+						break;
+					}
+				}
+			}
+			delete caches[ii];
+		}
+	}
+};
+
+static thread_local ThreadCacheList threadCaches;
+
+//_____________________________________________________________________________________________________Concurrent Memory Manager________________________________________________________________________________________________
+const unsigned int ConcurrentMemoryManager::SIZE_CLASSES;
+const unsigned int ConcurrentMemoryManager::MAX_CACHED_WORDS;
+
+ConcurrentMemoryManager::ConcurrentMemoryManager(MemoryManager& manager, unsigned int cacheLimit) : manager(manager) {
+	this->cacheLimit = cacheLimit == 0 ? 1 : cacheLimit;
+}
+
+//The caches of threads that are still running are detached, and deleted when those threads exit
+ConcurrentMemoryManager::~ConcurrentMemoryManager() {
+	std::lock_guard<std::mutex> registry(RegistryLock());
+	for (size_t ii = 0; ii < caches.size(); ii += 1) {
+		for (unsigned int sizeClass = 0; sizeClass < SIZE_CLASSES; sizeClass += 1) {
+			ReleaseBlocks(caches[ii], sizeClass, caches[ii]->bins[sizeClass].size());
+		}
+		caches[ii]->owner.store(nullptr);
+	}
+	caches.clear();
+}
+
+//Sizes in a class are served from the calling thread's cache first, and from the central heap when the cache is empty
+void* ConcurrentMemoryManager::allocate(size_t sizeInBytes) {
+	unsigned int wordSize = manager.getWordSize();
+	int sizeClass = SizeClass(sizeInBytes / wordSize);
+	if (sizeClass == -1) {
+		std::lock_guard<std::mutex> lock(heapLock);
+		return manager.allocate(sizeInBytes);
+	}
+
+	std::vector<void*>& bin = GetThreadCache()->bins[sizeClass];
+	if (!bin.empty()) {
+		void* block = bin.back();
+		bin.pop_back();
+		return block;
+	}
+	std::lock_guard<std::mutex> lock(heapLock);
+	return manager.allocate((size_t)wordSize << sizeClass);
+}
+
+//A full cache gives half of its blocks back in one trip to the central heap
+void ConcurrentMemoryManager::free(void* address, size_t sizeInBytes) {
+	if (address == nullptr) {
+		return;
+	}
+	int sizeClass = SizeClass(sizeInBytes / manager.getWordSize());
+	if (sizeClass == -1) {
+		free(address);
+		return;
+	}
+
+	ThreadCache* cache = GetThreadCache();
+	std::vector<void*>& bin = cache->bins[sizeClass];
+	bin.push_back(address);
+	if (bin.size() > cacheLimit) {
+		ReleaseBlocks(cache, sizeClass, bin.size() / 2);
+	}
+}
+
+void ConcurrentMemoryManager::free(void* address) {
+	std::lock_guard<std::mutex> lock(heapLock);
+	manager.free(address);
+}
+
+void ConcurrentMemoryManager::flushThreadCache() {
+	ThreadCache* cache = GetThreadCache();
+	for (unsigned int sizeClass = 0; sizeClass < SIZE_CLASSES; sizeClass += 1) {
+		ReleaseBlocks(cache, sizeClass, cache->bins[sizeClass].size());
+	}
+}
+
+void* ConcurrentMemoryManager::getList() {
+	std::lock_guard<std::mutex> lock(heapLock);
+	return manager.getList();
+}
+
+void* ConcurrentMemoryManager::getBitmap() {
+	std::lock_guard<std::mutex> lock(heapLock);
+	return manager.getBitmap();
+}
+
+MemoryManager::Stats ConcurrentMemoryManager::getStats() {
+	std::lock_guard<std::mutex> lock(heapLock);
+	return manager.getStats();
+}
+
+//Finds the calling thread's cache for this manager, creating it the first time the thread uses the manager
+ConcurrentMemoryManager::ThreadCache* ConcurrentMemoryManager::GetThreadCache() {
+	std::vector<ThreadCache*>& list = threadCaches.caches;
+	size_t ii = 0;
+	while (ii < list.size()) {
+		ConcurrentMemoryManager* owner = list[ii]->owner.load();
+		if (owner == this) {
+			return list[ii];
+		}
+		//The manager of this cache was destroyed and already took its blocks back
+		if (owner == nullptr) {
+			delete list[ii];
+			list.erase(list.begin() + ii);
+		}
+		else {
+			ii += 1;
+		}
+	}
+	ThreadCache* cache = new ThreadCache();
+	cache->owner.store(this);
+	list.push_back(cache);
+	std::lock_guard<std::mutex> registry(RegistryLock());
+	caches.push_back(cache);
+	return cache;
+}
+
+//Frees the last count blocks of a bin in the central heap under one lock
+void ConcurrentMemoryManager::ReleaseBlocks(ThreadCache* cache, unsigned int sizeClass, size_t count) {
+	std::vector<void*>& bin = cache->bins[sizeClass];
+	if (count == 0) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(heapLock);
+	for (size_t ii = bin.size() - count; ii < bin.size(); ii += 1) {
+		manager.free(bin[ii]);
+	}
+	bin.resize(bin.size() - count);
+}
+
+//Returns the class of the smallest power of 2 words holding sizeInWords, or -1 if the size is not cached
+int ConcurrentMemoryManager::SizeClass(size_t sizeInWords) {
+	if (sizeInWords == 0 || sizeInWords > MAX_CACHED_WORDS) {
+		return -1;
+	}
+	int sizeClass = 0;
+	while (((size_t)1 << sizeClass) < sizeInWords) {
+		sizeClass += 1;
+	}
+	return sizeClass;
+}
+
+//Guards which caches belong to which managers, shared by every manager so a thread exiting and a manager being destroyed are ordered
+std::mutex& ConcurrentMemoryManager::RegistryLock() {
+	static std::mutex registry;
+	return registry;
+}
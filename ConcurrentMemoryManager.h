@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include "MemoryManager.h"
+
+//Lets many threads allocate from one MemoryManager. The manager is the central heap and is only used behind a lock, and each thread keeps a cache
+//of blocks it freed for each size class, which serves most allocations and frees without taking the lock
+//Sizes up to MAX_CACHED_WORDS words are rounded up to a power of 2 words so the blocks of a class can be handed out again for any size in that class
+//A cached block stays allocated in the central heap, so getList() and getBitmap() show it as used until the cache gives it back
+class ConcurrentMemoryManager {
+public:
+	static const unsigned int SIZE_CLASSES = 10;
+	static const unsigned int MAX_CACHED_WORDS = 1u << (SIZE_CLASSES - 1);
+
+	//The blocks one thread has cached for one manager, one list per size class
+	struct ThreadCache {
+		std::atomic<ConcurrentMemoryManager*> owner;
+		std::vector<void*> bins[SIZE_CLASSES];
+	};
+
+	//___________Constructors and Destructors______________
+	//cacheLimit is the most blocks a thread caches per size class before half of them go back to the central heap
+	ConcurrentMemoryManager(MemoryManager& manager, unsigned int cacheLimit);
+	//Every thread cache gives its blocks back, the threads must be done using the manager
+	~ConcurrentMemoryManager();
+
+	//___________Allocating and Freeing_____________
+	void* allocate(size_t sizeInBytes);
+	//The sized free puts the block in the cache of the calling thread, sizeInBytes must be the size it was allocated with
+	void free(void* address, size_t sizeInBytes);
+	//Without the size the block is freed in the central heap
+	void free(void* address);
+	//Gives the blocks cached by the calling thread back to the central heap
+	void flushThreadCache();
+
+	//____________Getters Behind the Lock_____________
+	void* getList();
+	void* getBitmap();
+	MemoryManager::Stats getStats();
+
+private:
+	ThreadCache* GetThreadCache();
+	void ReleaseBlocks(ThreadCache* cache, unsigned int sizeClass, size_t count);
+	static int SizeClass(size_t sizeInWords);
+	static std::mutex& RegistryLock();
+	friend struct ThreadCacheList;
+
+	MemoryManager& manager;
+	unsigned int cacheLimit;
+	//Guards the central heap
+	std::mutex heapLock;
+	//Every cache created for this manager, guarded by RegistryLock() so a thread that exits can give its cache back while the manager is alive
+	std::vector<ThreadCache*> caches;
+};
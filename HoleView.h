@@ -0,0 +1,10 @@
+#pragma once
+#include <stdint.h>
+
+//The hole list split into two arrays, so an allocator that only compares sizes reads the sizes in one contiguous run
+//offsets[ii] and sizes[ii] are the offset and size in words of hole ii, in address order. The arrays are valid until the next allocate or free
+struct HoleView {
+	uint32_t count;
+	const uint32_t* offsets;
+	const uint32_t* sizes;
+};
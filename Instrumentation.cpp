@@ -0,0 +1,54 @@
+#include "Instrumentation.h"
+#include "BitOps.h"
+#include <chrono>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+//The counts of each thread, zero-initialized when the thread first records
+static thread_local Instrumentation::Snapshot threadCounts;
+
+const unsigned int Instrumentation::BUCKETS;
+
+uint64_t Instrumentation::cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void Instrumentation::record(Timer timer, uint64_t cycles) {
+	unsigned int bucket = cycles == 0 ? 0 : HighestSetBit(cycles) + 1;
+	threadCounts.calls[timer] += 1;
+	threadCounts.cycles[timer] += cycles;
+	threadCounts.histograms[timer][bucket < BUCKETS ? bucket : BUCKETS - 1] += 1;
+}
+
+void Instrumentation::count(Counter counter, uint64_t amount) {
+	threadCounts.counters[counter] += amount;
+}
+
+Instrumentation::Snapshot Instrumentation::snapshot() {
+	return threadCounts;
+}
+
+void Instrumentation::reset() {
+	memset(&threadCounts, 0, sizeof(threadCounts));
+}
+
+uint64_t Instrumentation::percentile(const Snapshot& snapshot, Timer timer, double fraction) {
+	uint64_t seen = 0;
+	for (unsigned int bucket = 0; bucket < BUCKETS; bucket += 1) {
+		seen += snapshot.histograms[timer][bucket];
+		if (seen > 0 && seen >= fraction * snapshot.calls[timer]) {
+			return bucket == 0 ? 0 : (1ull << bucket) - 1;
+		}
+	}
+	return 0;
+}
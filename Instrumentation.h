@@ -0,0 +1,54 @@
+#pragma once
+#include <stdint.h>
+
+//Optional counters for the allocate and free hot paths, built in when MEMORY_INSTRUMENTATION is defined (make INSTRUMENT=1)
+//Without it the MEMORY_ macros below expand to nothing, so the hot paths are the same code as if the counters did not exist
+//Every thread counts into its own copy, so recording takes no lock and snapshot() and reset() only see the calling thread
+class Instrumentation {
+public:
+	//The timed phases. A list allocator's time is split between building the hole list and scanning it, FIND_BLOCK is FindByOffset or FindByData
+	enum Timer { ALLOCATE, FREE, HOLE_LIST_BUILD, ALLOCATOR_SCAN, FIND_BLOCK, TIMERS };
+	//LIST_NODES_VISITED counts holes copied into the hole list, HOLES_SCANNED holes handed to a list allocator and COALESCES each merge of two holes
+	enum Counter { LIST_NODES_VISITED, HOLES_SCANNED, COALESCES, COUNTERS };
+	//Bucket 0 counts calls of 0 cycles and bucket ii calls of [2^(ii - 1), 2^ii) cycles, the last bucket also counts anything longer
+	static const unsigned int BUCKETS = 48;
+
+	struct Snapshot {
+		uint64_t calls[TIMERS];
+		uint64_t cycles[TIMERS];
+		uint64_t histograms[TIMERS][BUCKETS];
+		uint64_t counters[COUNTERS];
+	};
+
+	//___________Recording______________
+	//The time stamp counter where there is one, nanoseconds elsewhere
+	static uint64_t cycles();
+	static void record(Timer timer, uint64_t cycles);
+	static void count(Counter counter, uint64_t amount);
+
+	//___________Reading and Resetting the Calling Thread's Counts_____________
+	static Snapshot snapshot();
+	static void reset();
+	//The smallest cycle count that at least fraction of the calls took no longer than, rounded up to the top of its bucket
+	static uint64_t percentile(const Snapshot& snapshot, Timer timer, double fraction);
+
+	//Records the cycles from its construction to the end of the enclosing scope
+	class ScopedTimer {
+	public:
+		ScopedTimer(Timer timer) : timer(timer), start(cycles()) {}
+		~ScopedTimer() { record(timer, cycles() - start); }
+	private:
+		Timer timer;
+		uint64_t start;
+	};
+};
+
+#ifdef MEMORY_INSTRUMENTATION
+#define MEMORY_CONCATENATE_(lhs, rhs) lhs##rhs
+#define MEMORY_CONCATENATE(lhs, rhs) MEMORY_CONCATENATE_(lhs, rhs)
+#define MEMORY_TIME_SCOPE(timer) Instrumentation::ScopedTimer MEMORY_CONCATENATE(memoryTimer, __LINE__)(Instrumentation::timer)
+#define MEMORY_COUNT(counter, amount) Instrumentation::count(Instrumentation::counter, amount)
+#else
+#define MEMORY_TIME_SCOPE(timer)
+#define MEMORY_COUNT(counter, amount)
+#endif
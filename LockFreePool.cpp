@@ -0,0 +1,104 @@
+#include "LockFreePool.h"
+
+//_____________________________________________________________________________________________________Lock Free Pool________________________________________________________________________________________________
+const uint32_t LockFreePool::NO_OBJECT;
+
+//Objects are rounded up to whole words of the manager. If the chunk cannot be allocated the pool is empty
+LockFreePool::LockFreePool(MemoryManager& manager, size_t objectSize, uint32_t objectCount) : manager(manager), head(Pack(NO_OBJECT, 0)), casRetries(0), contendedOperations(0), exhausted(0) {
+	unsigned int wordSize = manager.getWordSize();
+	if (objectSize == 0) {
+		objectSize = 1;
+	}
+	this->objectSize = ((objectSize + wordSize - 1) / wordSize) * wordSize;
+	chunk = nullptr;
+	next = nullptr;
+	this->objectCount = 0;
+	if (objectCount == 0 || objectCount == NO_OBJECT) {
+		return;
+	}
+	chunk = static_cast<uint8_t*>(manager.allocate(this->objectSize * objectCount));
+	if (chunk == nullptr) {
+		return;
+	}
+	this->objectCount = objectCount;
+
+	//Every object starts on the stack, in address order from the top
+	next = new std::atomic<uint32_t>[objectCount];
+	for (uint32_t ii = 0; ii < objectCount; ii += 1) {
+		next[ii].store(ii + 1 < objectCount ? ii + 1 : NO_OBJECT, std::memory_order_relaxed);
+	}
+	head.store(Pack(0, 0));
+}
+
+LockFreePool::~LockFreePool() {
+	if (chunk != nullptr) {
+		manager.free(chunk);
+	}
+	delete[] next;
+}
+
+//Pops the top object. The tag goes up by one so a head that was popped and pushed back in between is told apart
+void* LockFreePool::allocate() {
+	uint64_t top = head.load(std::memory_order_acquire);
+	bool retried = false;
+	while (true) {
+		uint32_t index = (uint32_t)top;
+		if (index == NO_OBJECT) {
+			exhausted.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		uint64_t below = Pack(next[index].load(std::memory_order_relaxed), (uint32_t)(top >> 32) + 1);
+		if (head.compare_exchange_weak(top, below, std::memory_order_acquire, std::memory_order_acquire)) {
+			if (retried) {
+				contendedOperations.fetch_add(1, std::memory_order_relaxed);
+			}
+			return chunk + (index * objectSize);
+		}
+		//compare_exchange_weak reloaded top with the head another thread set
+		casRetries.fetch_add(1, std::memory_order_relaxed);
+		retried = true;
+	}
+}
+
+//Pushes the object on top of the stack
+void LockFreePool::free(void* object) {
+	uint8_t* address = static_cast<uint8_t*>(object);
+	if (chunk == nullptr || address < chunk || address >= chunk + (objectSize * objectCount) || (address - chunk) % objectSize != 0) {
+		return;
+	}
+	uint32_t index = (uint32_t)((address - chunk) / objectSize);
+
+	uint64_t top = head.load(std::memory_order_relaxed);
+	bool retried = false;
+	while (true) {
+		next[index].store((uint32_t)top, std::memory_order_relaxed);
+		if (head.compare_exchange_weak(top, Pack(index, (uint32_t)(top >> 32) + 1), std::memory_order_release, std::memory_order_relaxed)) {
+			if (retried) {
+				contendedOperations.fetch_add(1, std::memory_order_relaxed);
+			}
+			return;
+		}
+		casRetries.fetch_add(1, std::memory_order_relaxed);
+		retried = true;
+	}
+}
+
+size_t LockFreePool::getObjectSize() {
+	return objectSize;
+}
+
+uint32_t LockFreePool::getObjectCount() {
+	return objectCount;
+}
+
+LockFreePool::Counters LockFreePool::getCounters() {
+	Counters counters;
+	counters.casRetries = casRetries.load(std::memory_order_relaxed);
+	counters.contendedOperations = contendedOperations.load(std::memory_order_relaxed);
+	counters.exhausted = exhausted.load(std::memory_order_relaxed);
+	return counters;
+}
+
+uint64_t LockFreePool::Pack(uint32_t index, uint32_t tag) {
+	return ((uint64_t)tag << 32) | index;
+}
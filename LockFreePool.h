@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+#include "MemoryManager.h"
+
+//A pool of fixed size objects carved out of one chunk allocated from a MemoryManager, which many threads can allocate from and free to without a lock
+//The free objects form a Treiber stack. The head packs the index of the top object with a tag that changes on every push and pop,
+//so a thread whose compare-and-swap saw the same top object after other threads popped and pushed it back (The ABA problem) still fails
+//The links are kept beside the objects, so a free object's words are never read while another thread may be writing them
+class LockFreePool {
+public:
+	//Counts since the pool was created, each is updated with relaxed ordering so they are approximate while threads are running
+	struct Counters {
+		//Compare-and-swaps that failed because another thread changed the head first
+		uint64_t casRetries;
+		//Allocations and frees that needed at least one retry
+		uint64_t contendedOperations;
+		//Allocations that found the pool empty
+		uint64_t exhausted;
+	};
+
+	//___________Constructors and Destructors______________
+	//The chunk is allocated from the manager here and freed by the destructor, the manager is only used by the thread that does these
+	LockFreePool(MemoryManager& manager, size_t objectSize, uint32_t objectCount);
+	~LockFreePool();
+
+	//___________Allocating and Freeing Objects_____________
+	//Returns nullptr if every object is in use
+	void* allocate();
+	//Objects not from this pool are ignored
+	void free(void* object);
+
+	//____________Getters_____________
+	size_t getObjectSize();
+	uint32_t getObjectCount();
+	Counters getCounters();
+
+private:
+	static const uint32_t NO_OBJECT = UINT32_MAX;
+	static uint64_t Pack(uint32_t index, uint32_t tag);
+
+	MemoryManager& manager;
+	uint8_t* chunk;
+	size_t objectSize;
+	uint32_t objectCount;
+	//next[ii] is the object under object ii on the stack
+	std::atomic<uint32_t>* next;
+	//The top object's index in the low 32 bits and the tag in the high 32 bits
+	std::atomic<uint64_t> head;
+	std::atomic<uint64_t> casRetries;
+	std::atomic<uint64_t> contendedOperations;
+	std::atomic<uint64_t> exhausted;
+};
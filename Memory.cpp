@@ -1,27 +1,27 @@
 #include "Memory.h"
+#include "AllocatorEngine.h"
+#include "BitOps.h"
 //______________________________________________________________________________________________________Memory Blocks______________________________________________________________________________________________________
-//Constructor which initializes all block variables
+//Constructor which initializes all block variables, the block is linked into the list by the pool that holds it
 Memory::Block::Block(unsigned int size, bool used, unsigned int offset) {
 	this->used = used;
 	this->size = size;
 	this->offset = offset;
-	next = nullptr;
-	prev = nullptr;
-	data = new uint64_t[size];
+	next = NO_BLOCK;
+	prev = NO_BLOCK;
 }
 
-//Delete the data array to reset its size
+//The words of a block are found from its offset, so resizing a block only changes how many words it covers
 void Memory::Block::ResetSize(unsigned int size) {
-	delete[] data;
 	this->size = size;
-	data = new uint64_t[size];
 }
 
-//The following functions are all simple modifiers and getters
 void Memory::Block::ResetOffset(unsigned int offset) {
 	this->offset = offset; 
 }
 
+//The following functions are all simple modifiers and getters
+
 void Memory::Block::set_block_status(bool used) {
 	this->used = used;
 }
@@ -38,131 +38,120 @@ bool Memory::Block::getUsedStatus() {
 	return used;
 }
 
-uint64_t* Memory::Block::getData() {
-	return data;
-}
-
 //_______________________________________________________________________________________________________Memory______________________________________________________________________________________________________________
-//Default constructor, initializes all pointers to nullptr and all variables to 0
+const uint32_t Memory::NO_BLOCK;
+
+//Default constructor, initializes the list to be empty and all variables to 0
 Memory::Memory() {
-	head = nullptr;
-	tail = nullptr;
+	head = NO_BLOCK;
+	tail = NO_BLOCK;
+	freeBlocks = NO_BLOCK;
 	memory_capacity = 0;
 	listSize = 0;
 	listData = nullptr;
+	arena = nullptr;
+	engine = nullptr;
+	freeWords = 0;
+	holeCount = 0;
 }
 
-//Constructor which initializes only the capacity of the list
+//Constructor which initializes the capacity of the list and the contiguous arena every block is carved out of
 Memory::Memory(unsigned int capacity) {
-	head = nullptr;
-	tail = nullptr;
+	head = NO_BLOCK;
+	tail = NO_BLOCK;
+	freeBlocks = NO_BLOCK;
 	memory_capacity = capacity;
 	listSize = 0;
 	listData = nullptr;
+	arena = nullptr;
+	engine = nullptr;
+	freeWords = 0;
+	holeCount = 0;
+	Initialize(capacity);
 }
 
 //Copy constructor which copies all elements of the rhs list upon creation of the lhs list
+//Blocks are linked by index, so copying the pool copies the list
 Memory::Memory(const Memory& rhs) {
-	memory_capacity = rhs.memory_capacity;
-	Block* oldCurrent = rhs.head;
-	head = new Block(oldCurrent->size, oldCurrent->used, oldCurrent->offset);
-	Block* newCurrent = head;
-	while (oldCurrent->next != nullptr) {
-		oldCurrent = oldCurrent->next;
-		Block* temp = new Block(oldCurrent->size, oldCurrent->used, oldCurrent->offset);
-		newCurrent->next = temp;
-		temp->prev = newCurrent;
-		newCurrent = newCurrent->next;
-	}
-	tail = newCurrent;
-
-	if (rhs.listData == nullptr) {
-		listSize = rhs.listSize;
-		listData = nullptr;
-	}
-	else {
-		listSize = rhs.listSize;
-		listData = new uint64_t[listSize];
-		for (unsigned int ii = 0; ii < listSize; ii += 1) {
-			listData[ii] = rhs.listData[ii];
-		}
-	}
+	arena = nullptr;
+	listData = nullptr;
+	*this = rhs;
 }
 
 //Overloaded copy assignment operator which clears the lhs list and copies the rhs list into it
 Memory& Memory::operator=(const Memory& rhs) {
-	//Deleting all elements from this list so we have a fresh slate to copy the rhs list
-	this->Clear();
-	if (rhs.head == nullptr) {
-		head = nullptr;
-		tail = nullptr; 
-		memory_capacity = rhs.memory_capacity;
+	if (this == &rhs) {
 		return *this;
 	}
-	else {
-		//Old current points to the head of the list we want to copy
-		Block* oldCurrent = rhs.head;
-		//To create a deep copy, we set head equal to a new node we create 
-		//And copy the value from the old list
-		head = new Block(oldCurrent->size, oldCurrent->used, oldCurrent->offset);
-		Block* newCurrent = head;
-		//We will now iterate through the old list
-		while (oldCurrent->next != nullptr) {
-			//old current points to next element in the old list
-			oldCurrent = oldCurrent->next;
-			//We now create a new node with the value from the old list
-			Block* temp = new Block(oldCurrent->size, oldCurrent->used, oldCurrent->offset);
-			//This connects the new node to the new list
-			newCurrent->next = temp;
-			temp->prev = newCurrent;
-			//Move over 1 element in the new list
-			newCurrent = newCurrent->next;
-		}
-		//Make sure to set tail of new list at the last node
-		tail = newCurrent;
-		memory_capacity = rhs.memory_capacity;
-
-
-		if (rhs.listData == nullptr) {
-			listSize = rhs.listSize;
-			listData = nullptr;
-		}
-		else {
-			listSize = rhs.listSize;
-			listData = new uint64_t[listSize];
-			for (unsigned int ii = 0; ii < listSize; ii += 1) {
-				listData[ii] = rhs.listData[ii];
-			}
+	//Deleting all elements from this list so we have a fresh slate to copy the rhs list
+	this->Clear();
+	CopyArena(rhs);
+	memory_capacity = rhs.memory_capacity;
+	blocks = rhs.blocks;
+	blockIndex = rhs.blockIndex;
+	freeBlocks = rhs.freeBlocks;
+	head = rhs.head;
+	tail = rhs.tail;
+	holes = rhs.holes;
+	holeSizes = rhs.holeSizes;
+	freeWords = rhs.freeWords;
+	holeCount = rhs.holeCount;
+	occupancy = rhs.occupancy;
+	//The engine is not copied, so the holes it indexed are read from the blocks
+	if (rhs.engine != nullptr) {
+		RebuildHoles();
+	}
+
+	listSize = rhs.listSize;
+	if (rhs.listData != nullptr) {
+		listData = new uint64_t[listSize];
+		for (unsigned int ii = 0; ii < listSize; ii += 1) {
+			listData[ii] = rhs.listData[ii];
 		}
-
-		return *this;
 	}
+	return *this;
 }
 
-//Destructor which deletes each block and each block's data in the list and resets all variables to 0 (Called when list falls out of scope)
+//Destructor which deletes the arena and resets all variables to 0 (Called when list falls out of scope)
 Memory::~Memory() {
 	Clear();
 }
 
+//Clears the list and creates an empty arena of capacity words in place, so nothing is built twice or copied
+void Memory::Initialize(unsigned int capacity) {
+	Clear();
+	memory_capacity = capacity;
+	if (capacity != 0) {
+		arena = new uint64_t[capacity];
+		blockIndex.assign(capacity, NO_BLOCK);
+		occupancy.assign((capacity + 63) / 64, 0);
+	}
+}
+
 //A clear function to delete lists which is exactly the same as the destructor but can be called anytime in the lifetime of the list (Useful for deleting and reassigning lists)
 void Memory::Clear() {
-	if (head == nullptr) {
-		head = nullptr;
-		tail = nullptr;
-	}
-	else {
-		Block* current = head;
-		while (current->next != nullptr) {
-			head = head->next;
-			delete[] current->data;
-			delete current;
-			current = head;
-		}
-		delete[] head->data;
-		delete head;
-		head = nullptr;
-		tail = nullptr;
-	}
+	//Every block is a record in the pool, so the list is emptied by emptying the pool
+	blocks.clear();
+	blocks.shrink_to_fit();
+	freeBlocks = NO_BLOCK;
+	head = NO_BLOCK;
+	tail = NO_BLOCK;
+
+	//Block data are views into the arena, so the arena is the only data to delete
+	if (arena != nullptr) {
+		delete[] arena;
+		arena = nullptr;
+	}
+	blockIndex.clear();
+	blockIndex.shrink_to_fit();
+	holes.clear();
+	holeSizes.clear();
+	freeWords = 0;
+	holeCount = 0;
+	occupancy.clear();
+	occupancy.shrink_to_fit();
+	//The engine indexed the holes of this list, so it is detached along with them
+	engine = nullptr;
 
 	if (listData != nullptr) {
 		delete[] listData; 
@@ -175,284 +164,227 @@ void Memory::Clear() {
 
 //Function to add a block of memory to the front of the list
 void Memory::AddHead(const unsigned int& size, bool used) {
-	//If head is nullptr, this is the first element in our list so create a new block and assign the head and tail to it
-	if (head == nullptr) {
-		head = new Block(size, used, 0);
-		tail = head;
+	//Create a new block, the next block is the old head. If head is NO_BLOCK, this is the first element in our list so it is the tail as well
+	uint32_t index = NewBlock(size, used, 0);
+	blocks[index].next = head;
+	if (head == NO_BLOCK) {
+		tail = index;
 	}
-	//Otherwise create a new block, assign head to it, the next block is the old head
 	else {
-		Block* temp = new Block(size, used, 0);
-		temp->next = head;
-		head->prev = temp;
-		head = temp;
+		blocks[head].prev = index;
+	}
+	head = index;
+	IndexBlock(index);
+	if (!used) {
+		AddHole(0, size);
+	}
+	else {
+		SetOccupancy(0, size, true);
 	}
 }
 
 //If a free block is called to be allocated and it has extra room, split the block into a free part and a used part
+//The used part is placed before the free part. Returns nullptr if the pool has no room for another block
 Memory::Block* Memory::SplitBlock(Block* blockToSplit, unsigned int size) {
+	//Creating a block can move the pool, so the block to split is held by its index
+	uint32_t splitIndex = IndexOf(blockToSplit);
+	if (freeBlocks == NO_BLOCK && blocks.size() >= NO_BLOCK) {
+		return nullptr;
+	}
+	//A block of 0 words would start at the same offset as the rest of the block and take its place in the block index
+	if (size == 0 || size >= blockToSplit->size) {
+		return nullptr;
+	}
+
 	//Size of the free block will be totalBlockSize - sizeToBeAllocated
 	//The offset of the free block will be the current offset plus the size of what will be allocated
 	unsigned int newSize = blockToSplit->size - size;
 	unsigned int newOffset = blockToSplit->offset + size;
 	unsigned int oldOffset = blockToSplit->offset;
 
-	//If this is the head, reset the size and offset. Then add a head of the size to be allocated
-	if (head == blockToSplit) {
-		blockToSplit->ResetSize(newSize);
-		blockToSplit->ResetOffset(newOffset);
-		AddHead(size, true);
-		return head; 
+	//The hole being split shrinks to the part that remains free
+	if (!blockToSplit->used) {
+		RemoveHole(oldOffset);
+		AddHole(newOffset, newSize);
 	}
+	blockToSplit->ResetSize(newSize);
+	blockToSplit->ResetOffset(newOffset);
 
-	//If this is the tail, the new allocated block will be placed between the resized tail and the tail's previous block
-	else if (tail == blockToSplit) {
-		blockToSplit->ResetSize(newSize);
-		blockToSplit->ResetOffset(newOffset);
-		Block* temp = tail->prev;
-
-		Block* newFilledBlock = new Block(size, true, oldOffset);
-		temp->next = newFilledBlock;
-		newFilledBlock->prev = temp;
-
-		newFilledBlock->next = tail;
-		tail->prev = newFilledBlock;
-
-		return newFilledBlock;
+	//The new allocated block is placed between the resized block and the block before it, or at the head if there is none
+	uint32_t filledIndex = NewBlock(size, true, oldOffset);
+	uint32_t prevIndex = blocks[splitIndex].prev;
+	blocks[filledIndex].prev = prevIndex;
+	blocks[filledIndex].next = splitIndex;
+	blocks[splitIndex].prev = filledIndex;
+	if (prevIndex == NO_BLOCK) {
+		head = filledIndex;
 	}
-
-	//If this is a general block, then place the new allocated block between the current block after its resized and the previous block
 	else {
-		blockToSplit->ResetSize(newSize);
-		blockToSplit->ResetOffset(newOffset);
-		Block* temp = blockToSplit->prev;
-
-		Block* newFilledBlock = new Block(size, true, oldOffset);
-		temp->next = newFilledBlock;
-		newFilledBlock->prev = temp;
-
-		newFilledBlock->next = blockToSplit;
-		temp->prev = newFilledBlock;
-
-		return newFilledBlock;
+		blocks[prevIndex].next = filledIndex;
 	}
-}
-
-//If a block is freed and the block to the left is also free, these are compacted into one large free block
-Memory::Block* Memory::CompactLeft(Memory::Block* blockToCompact) {
-	//Size of the compacted block is the two blocks sizes together, the offset is the offset of the leftmost block
-	unsigned int newSize = blockToCompact->getSize() + blockToCompact->prev->getSize();
-	unsigned int newOffset = blockToCompact->prev->getOffset();
-	Memory::Block* newBlock = new Block(newSize, false, newOffset);
-
-	//In all the following cases, delete the current block and the block to the left. The new compacted block will take up the space these blocks used to reside in.
-	//General case, delete both blocks and their data. Then connect the new compacted block to the old neighbors of the blocks that were compacted
-	if (blockToCompact->prev->prev != nullptr && blockToCompact->next != nullptr) {
-		Memory::Block* tempLeft = blockToCompact->prev->prev;
-		Memory::Block* tempRight = blockToCompact->next;
 
-		delete[] blockToCompact->prev->data;
-		delete[] blockToCompact->data;
-		delete blockToCompact->prev;
-		delete blockToCompact;
+	IndexBlock(splitIndex);
+	IndexBlock(filledIndex);
+	SetOccupancy(oldOffset, size, true);
+	return &blocks[filledIndex];
+}
 
-		newBlock->prev = tempLeft;
-		newBlock->next = tempRight;
-		tempLeft->next = newBlock;
-		tempRight->prev = newBlock;
-		return newBlock;
+//Grows a used block to size words by taking the words it needs from the start of the free block after it, a partial CompactRight
+//The free block keeps what is left, or is unlinked if the used block takes all of it
+bool Memory::GrowBlock(Block* blockToGrow, unsigned int size) {
+	Memory::Block* right = Next(blockToGrow);
+	unsigned int extra = size - blockToGrow->size;
+	if (right == nullptr || right->used || right->size < extra) {
+		return false;
 	}
+	unsigned int oldEnd = blockToGrow->offset + blockToGrow->size;
 
-	//If these were the only two blocks in the list, then compact them and the compacted block is the new head and tail
-	else if (blockToCompact->prev->prev == nullptr && blockToCompact->next == nullptr) {
-		delete[] blockToCompact->prev->data;
-		delete[] blockToCompact->data;
-		delete blockToCompact->prev;
-		delete blockToCompact;
-		head = newBlock;
-		tail = newBlock;
-		return newBlock;
+	RemoveHole(right->offset);
+	if (right->size == extra) {
+		UnlinkBlock(IndexOf(right));
 	}
+	else {
+		blockIndex[right->offset] = NO_BLOCK;
+		right->ResetOffset(right->offset + extra);
+		right->ResetSize(right->size - extra);
+		IndexBlock(IndexOf(right));
+		AddHole(right->offset, right->size);
+	}
+	blockToGrow->ResetSize(size);
+	SetOccupancy(oldEnd, extra, true);
+	return true;
+}
 
-	//If the two blocks are the leftmost blocks in the list then they become the new head
-	else if (blockToCompact->prev->prev == nullptr) {
-		Memory::Block* tempRight = blockToCompact->next;
-
-		delete[] blockToCompact->prev->data;
-		delete[] blockToCompact->data;
-		delete blockToCompact->prev;
-		delete blockToCompact;
-
-		newBlock->next = tempRight;
-		tempRight->prev = newBlock;
-
-		head = newBlock;
-		return newBlock;
+//Shrinks a used block to size words. The words cut off join the free block after it, or become a new free block if the next block is used
+//Returns false if a new free block is needed and the pool has no room for it
+bool Memory::ShrinkBlock(Block* blockToShrink, unsigned int size) {
+	//Creating a block can move the pool, so the block to shrink is held by its index
+	uint32_t shrinkIndex = IndexOf(blockToShrink);
+	unsigned int tailOffset = blockToShrink->offset + size;
+	unsigned int tailSize = blockToShrink->size - size;
+	Memory::Block* right = Next(blockToShrink);
+
+	if (right != nullptr && !right->used) {
+		RemoveHole(right->offset);
+		blockIndex[right->offset] = NO_BLOCK;
+		right->ResetOffset(tailOffset);
+		right->ResetSize(right->size + tailSize);
+		IndexBlock(IndexOf(right));
+		AddHole(right->offset, right->size);
 	}
+	else {
+		if (freeBlocks == NO_BLOCK && blocks.size() >= NO_BLOCK) {
+			return false;
+		}
+		//The new free block is placed between the shrunk block and the block after it, or at the tail if there is none
+		uint32_t tailIndex = NewBlock(tailSize, false, tailOffset);
+		uint32_t nextIndex = blocks[shrinkIndex].next;
+		blocks[tailIndex].prev = shrinkIndex;
+		blocks[tailIndex].next = nextIndex;
+		blocks[shrinkIndex].next = tailIndex;
+		if (nextIndex == NO_BLOCK) {
+			tail = tailIndex;
+		}
+		else {
+			blocks[nextIndex].prev = tailIndex;
+		}
+		IndexBlock(tailIndex);
+		AddHole(tailOffset, tailSize);
+	}
+	blocks[shrinkIndex].ResetSize(size);
+	SetOccupancy(tailOffset, tailSize, false);
+	return true;
+}
 
-	//If the two blocks are the rightmost blocks in the list then they become the new tail
-	else if (blockToCompact->next == nullptr) {
-		Memory::Block* tempLeft = blockToCompact->prev->prev;
-
-		delete[] blockToCompact->prev->data;
-		delete[] blockToCompact->data;
-		delete blockToCompact->prev;
-		delete blockToCompact;
+//If a block is freed and the block to the left is also free, these are compacted into one large free block
+//The left block grows to cover both and the current block is unlinked, so no block is created and no words are moved
+Memory::Block* Memory::CompactLeft(Memory::Block* blockToCompact) {
+	Memory::Block* left = Prev(blockToCompact);
 
-		newBlock->prev = tempLeft;
-		tempLeft->next = newBlock;
+	//Both holes are replaced by one hole spanning them
+	RemoveHole(blockToCompact->offset);
+	RemoveHole(left->offset);
+	left->ResetSize(left->size + blockToCompact->size);
+	AddHole(left->offset, left->size);
 
-		tail = newBlock;
-		return newBlock;
-	}
-	return nullptr;
+	UnlinkBlock(IndexOf(blockToCompact));
+	return left;
 }
 
 //If a block is freed and the block to the right is also free, these are compacted into one large free block
+//The current block grows to cover both and the right block is unlinked
 Memory::Block* Memory::CompactRight(Memory::Block* blockToCompact) {
-	//Size of the compacted block is the two blocks sizes together, the offset is the offset of the leftmost block
-	unsigned int newSize = blockToCompact->getSize() + blockToCompact->next->getSize();
-	unsigned int newOffset = blockToCompact->getOffset();
-	Memory::Block* newBlock = new Block(newSize, false, newOffset);
-
-	//In all the following cases, delete the current block and the block to the right. The new compacted block will take up the space these blocks used to reside in.
-	//General case, delete both blocks and their data. Then connect the new compacted block to the old neighbors of the blocks that were compacted
-	if (blockToCompact->next->next != nullptr && blockToCompact->prev != nullptr) {
-		Memory::Block* tempLeft = blockToCompact->prev;
-		Memory::Block* tempRight = blockToCompact->next->next;
-
-		delete[] blockToCompact->next->data;
-		delete[] blockToCompact->data;
-		delete blockToCompact->next;
-		delete blockToCompact;
-
-
-		newBlock->prev = tempLeft;
-		newBlock->next = tempRight;
-		tempLeft->next = newBlock;
-		tempRight->prev = newBlock;
-		return newBlock;
-	}
-
-	//If these were the only two blocks in the list, then compact them and the compacted block is the new head and tail
-	else if (blockToCompact->next->next == nullptr && blockToCompact->prev == nullptr) {
-		delete[] blockToCompact->next->data;
-		delete[] blockToCompact->data;
-		delete blockToCompact->next;
-		delete blockToCompact;
-		head = newBlock;
-		tail = newBlock;
-		return newBlock;
-	}
-
-	//If the two blocks are the rightmost blocks in the list then they become the new tail
-	else if (blockToCompact->next->next == nullptr) {
-		Memory::Block* tempLeft = blockToCompact->prev;
-
-		delete[] blockToCompact->next->data;
-		delete[] blockToCompact->data;
-		delete blockToCompact->next;
-		delete blockToCompact;
-
-		newBlock->prev = tempLeft;
-		tempLeft->next = newBlock;
-
-		tail = newBlock;
-		return newBlock;
-	}
+	Memory::Block* right = Next(blockToCompact);
 
-	//If the two blocks are the leftmost blocks in the list then they become the new head
-	else if (blockToCompact->prev == nullptr) {
-		Memory::Block* tempRight = blockToCompact->next->next;
+	//Both holes are replaced by one hole spanning them
+	RemoveHole(right->offset);
+	RemoveHole(blockToCompact->offset);
+	blockToCompact->ResetSize(blockToCompact->size + right->size);
+	AddHole(blockToCompact->offset, blockToCompact->size);
 
-		delete[] blockToCompact->next->data;
-		delete[] blockToCompact->data;
-		delete blockToCompact->next;
-		delete blockToCompact;
-
-		newBlock->next = tempRight;
-		tempRight->prev = newBlock;
-
-		head = newBlock;
-		return newBlock;
-	}
-	return nullptr;
+	UnlinkBlock(IndexOf(right));
+	return blockToCompact;
 }
 
+//Looks the offset up in the block index, which every split and compaction keeps up to date, instead of walking the list
+//Returns nullptr if the offset is outside the list or does not start a block
 Memory::Block* Memory::FindByOffset(const unsigned int& offset) {
-	Block* current = head;
-	while (current->next != nullptr) {
-		if (current->offset == offset) {
-			return current;
-		}
-		current = current->next;
-	}
-	if (current->offset == offset) {
-		return current;
-	}
-	else {
+	if (offset >= memory_capacity) {
 		return nullptr;
 	}
+	return At(blockIndex[offset]);
 }
 
-//Loops through the list to find a block whose data matches the one that is being looked for
+//Every block's data is arena + offset, so the offset of the data is found by address arithmetic and looked up in the block index
+//Returns nullptr if the data is outside the arena, not word aligned, or does not start a block
 Memory::Block* Memory::FindByData(const uint64_t* dataToFind) {
-	Block* current = head;
-	while (current->next != nullptr) {
-		if (current->data == dataToFind) {
-			return current;
-		}
-		current = current->next;
+	if (arena == nullptr) {
+		return nullptr;
 	}
-	if (current->data == dataToFind) {
-		return current;
+	uintptr_t address = reinterpret_cast<uintptr_t>(dataToFind);
+	uintptr_t base = reinterpret_cast<uintptr_t>(arena);
+	if (address < base || (address - base) % sizeof(uint64_t) != 0) {
+		return nullptr;
 	}
-	else {
+	uintptr_t offset = (address - base) / sizeof(uint64_t);
+	if (offset >= memory_capacity) {
 		return nullptr;
 	}
+	return At(blockIndex[offset]);
 }
 
-//Loops through the list and finds the offset and size of all blocks which are free
+//Copies the offset and size of all blocks which are free from the hole list, which is kept in address order as blocks are split and compacted
 void Memory::FindFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v) {
-	Block* current = head;
-	while (current->next != nullptr) {
-		if (!current->used) {
-			std::pair<unsigned int, unsigned int> temp = std::make_pair(current->getOffset(), current->getSize());
-			v.push_back(temp);
+	v.reserve(v.size() + holeCount);
+	//With an engine attached the hole maps are empty, so the blocks are walked instead
+	if (engine != nullptr) {
+		for (uint32_t current = head; current != NO_BLOCK; current = blocks[current].next) {
+			if (!blocks[current].used) {
+				v.push_back(std::make_pair(blocks[current].offset, blocks[current].size));
+			}
 		}
-		current = current->next;
+		return;
 	}
-	if (!current->used) {
-		std::pair<unsigned int, unsigned int> temp = std::make_pair(current->getOffset(), current->getSize());
-		v.push_back(temp);
+	for (std::map<unsigned int, unsigned int>::iterator it = holes.begin(); it != holes.end(); ++it) {
+		v.push_back(std::make_pair(it->first, it->second));
 	}
 }
 
 //Loops through the list and gets the data from all blocks which are allocated
 uint64_t* Memory::FindFilledBlocks() {
 	std::vector <uint64_t> v;
-	Block* current = head;
-	while (current->next != nullptr) {
-		if (current->used) {
-			for (unsigned int ii = 0; ii < current->size; ii += 1) {
-				v.push_back(current->data[ii]);
+	for (uint32_t current = head; current != NO_BLOCK; current = blocks[current].next) {
+		if (blocks[current].used) {
+			uint64_t* data = arena + blocks[current].offset;
+			for (unsigned int ii = 0; ii < blocks[current].size; ii += 1) {
+				v.push_back(data[ii]);
 			}
 		}
-		current = current->next;
-	}
-	if (current->used) {
-		for (unsigned int ii = 0; ii < current->size; ii += 1) {
-			v.push_back(current->data[ii]);
-		}
 	}
 	if (listData != nullptr) {
 		delete[] listData;
-		listData = new uint64_t[v.size()];
-
-	}
-	else {
-		listData = new uint64_t[v.size()];
 	}
+	listData = new uint64_t[v.size()];
 	for (unsigned int ii = 0; ii < v.size(); ii += 1) {
 		listData[ii] = v.at(ii);
 	}
@@ -461,28 +393,84 @@ uint64_t* Memory::FindFilledBlocks() {
 
 //Loops through the list and for each block, places a number of elements equal to the size of the block into the vector. These elements will be all 0 for a free block or all 1 for a used block
 void Memory::BitRepresentation(std::vector<int>& v) {
-	Block* current = head;
-	while (current->next != nullptr) {
-		if (current->used) {
-			for (int ii = 0; ii < current->size; ii += 1) {
-				v.push_back(1);
-			}
-		}
-		else {
-			for (int ii = 0; ii < current->size; ii += 1) {
-				v.push_back(0);
-			}
-		}
-		current = current->next;
+	for (uint32_t current = head; current != NO_BLOCK; current = blocks[current].next) {
+		v.insert(v.end(), blocks[current].size, blocks[current].used ? 1 : 0);
 	}
-	if (current->used) {
-		for (int ii = 0; ii < current->size; ii += 1) {
-			v.push_back(1);
-		}
+}
+
+//The neighbours of a block in the list, or nullptr at either end
+Memory::Block* Memory::Next(Block* block) {
+	return At(block->next);
+}
+
+Memory::Block* Memory::Prev(Block* block) {
+	return At(block->prev);
+}
+
+//The words of a block are a view into the arena at its offset
+uint64_t* Memory::GetData(Block* block) {
+	return arena + block->offset;
+}
+
+//Returns the block at a pool index, or nullptr for NO_BLOCK
+Memory::Block* Memory::At(uint32_t index) {
+	if (index == NO_BLOCK) {
+		return nullptr;
+	}
+	return &blocks[index];
+}
+
+uint32_t Memory::IndexOf(Block* block) {
+	return (uint32_t)(block - blocks.data());
+}
+
+//Creates a block at offset in the first free record of the pool, and only grows the pool if no record is free
+uint32_t Memory::NewBlock(unsigned int size, bool used, unsigned int offset) {
+	if (freeBlocks == NO_BLOCK) {
+		blocks.push_back(Block(size, used, offset));
+		return (uint32_t)(blocks.size() - 1);
+	}
+	uint32_t index = freeBlocks;
+	freeBlocks = blocks[index].next;
+	blocks[index] = Block(size, used, offset);
+	return index;
+}
+
+//Removes a block from the list and the block index, and puts its record on the free list to be reused by the next split
+void Memory::UnlinkBlock(uint32_t index) {
+	Block& block = blocks[index];
+	if (block.prev != NO_BLOCK) {
+		blocks[block.prev].next = block.next;
+	}
+	else {
+		head = block.next;
+	}
+	if (block.next != NO_BLOCK) {
+		blocks[block.next].prev = block.prev;
 	}
 	else {
-		for (int ii = 0; ii < current->size; ii += 1) {
-			v.push_back(0);
+		tail = block.prev;
+	}
+	blockIndex[block.offset] = NO_BLOCK;
+
+	block.next = freeBlocks;
+	freeBlocks = index;
+}
+
+//Records the block as the one starting at its offset
+void Memory::IndexBlock(uint32_t index) {
+	blockIndex[blocks[index].offset] = index;
+}
+
+//Copies the rhs arena so the blocks of this list can view the same words the rhs blocks held
+void Memory::CopyArena(const Memory& rhs) {
+	if (rhs.arena == nullptr) {
+		arena = nullptr;
+	}
+	else {
+		arena = new uint64_t[rhs.memory_capacity];
+		for (unsigned int ii = 0; ii < rhs.memory_capacity; ii += 1) {
+			arena[ii] = rhs.arena[ii];
 		}
 	}
 }
@@ -492,10 +480,112 @@ unsigned int Memory::GetCapacity() {
 	return memory_capacity;
 }
 
+uint64_t* Memory::GetArena() {
+	return arena;
+}
+
 void Memory::FillBlock(Block* blockToFill) {
 	blockToFill->set_block_status(true);
+	RemoveHole(blockToFill->offset);
+	SetOccupancy(blockToFill->offset, blockToFill->size, true);
+}
+
+void Memory::FreeBlock(Block* blockToFree) {
+	blockToFree->set_block_status(false);
+	AddHole(blockToFree->offset, blockToFree->size);
+	SetOccupancy(blockToFree->offset, blockToFree->size, false);
+}
+
+//Returns the packed bitmap of the list, bit (ii % 64) of element (ii / 64) is 1 if word ii is allocated
+const std::vector<uint64_t>& Memory::GetOccupancy() {
+	return occupancy;
+}
+
+//Sets or clears the bits of the words [offset, offset + size)
+void Memory::SetOccupancy(unsigned int offset, unsigned int size, bool used) {
+	SetBitRange(occupancy, offset, size, used);
 }
 
+//Returns the holes of the list as offset -> size in address order
+const std::map<unsigned int, unsigned int>& Memory::GetHoles() {
+	return holes;
+}
 
+uint64_t Memory::GetFreeWords() {
+	return freeWords;
+}
 
+unsigned int Memory::GetHoleCount() {
+	return holeCount;
+}
 
+//Returns 0 if the list has no holes
+unsigned int Memory::GetLargestHole() {
+	if (engine != nullptr) {
+		return engine->GetLargestHole();
+	}
+	return holeSizes.empty() ? 0 : holeSizes.rbegin()->first;
+}
+
+//Attaches an allocator engine which is told about every hole the list gains or loses, starting with the holes it has now
+//The holes move between the engine and the hole maps, so only one of them is updated as blocks are split and compacted
+void Memory::SetEngine(AllocatorEngine* engine) {
+	this->engine = engine;
+	RebuildHoles();
+}
+
+//Every change to the set of free blocks goes through these two functions, which also keep the free word and hole counts
+void Memory::AddHole(unsigned int offset, unsigned int size) {
+	freeWords += size;
+	holeCount += 1;
+	if (engine != nullptr) {
+		engine->InsertHole(offset, size);
+		return;
+	}
+	holes[offset] = size;
+	holeSizes[size] += 1;
+}
+
+//The offset must start a free block that has not been resized yet, so with an engine its size is read from the block
+void Memory::RemoveHole(unsigned int offset) {
+	if (engine != nullptr) {
+		unsigned int size = blocks[blockIndex[offset]].size;
+		engine->EraseHole(offset, size);
+		freeWords -= size;
+		holeCount -= 1;
+		return;
+	}
+	std::map<unsigned int, unsigned int>::iterator it = holes.find(offset);
+	if (it == holes.end()) {
+		return;
+	}
+	std::map<unsigned int, unsigned int>::iterator sizeCount = holeSizes.find(it->second);
+	sizeCount->second -= 1;
+	if (sizeCount->second == 0) {
+		holeSizes.erase(sizeCount);
+	}
+	freeWords -= it->second;
+	holeCount -= 1;
+	holes.erase(it);
+}
+
+//Fills the engine, or the hole maps if there is no engine, from the free blocks of the list
+void Memory::RebuildHoles() {
+	holes.clear();
+	holeSizes.clear();
+	if (engine != nullptr) {
+		engine->Reset(memory_capacity, arena);
+	}
+	for (uint32_t current = head; current != NO_BLOCK; current = blocks[current].next) {
+		if (blocks[current].used) {
+			continue;
+		}
+		if (engine != nullptr) {
+			engine->InsertHole(blocks[current].offset, blocks[current].size);
+		}
+		else {
+			holes[blocks[current].offset] = blocks[current].size;
+			holeSizes[blocks[current].size] += 1;
+		}
+	}
+}
@@ -1,17 +1,20 @@
 #pragma once
 #include <vector>
+#include <map>
 #include <stdint.h>
 
+class AllocatorEngine;
+
 class Memory {
 public:
-	//Each block stores if it is free or allocated (used), the offset and size, and the allocated data (If applicable)
+	//Each block stores if it is free or allocated (used), the offset and size, and the pool indices of its neighbours in 16 bytes
+	//Blocks live in one contiguous pool, so a Block* is only valid until the next block is created. Its words are GetData(block)
 	struct Block {
-		bool used;
-		unsigned int size;
 		unsigned int offset;
-		Block* next;
-		Block* prev;
-		uint64_t* data;
+		unsigned int size;
+		uint32_t next;
+		uint32_t prev : 31;
+		uint32_t used : 1;
 
 		//__________________Constructor________________________
 		Block(unsigned int size, bool used, unsigned int offset);
@@ -25,25 +28,39 @@ public:
 		unsigned int getSize();
 		unsigned int getOffset();
 		bool getUsedStatus();
-		uint64_t* getData();
 	};
 
+	//The index that ends the list and the free list, which is also the most blocks the pool can hold
+	static const uint32_t NO_BLOCK = 0x7FFFFFFF;
+
 	//___________Constructors and Destructors______________
 	Memory();
 	Memory(unsigned int capacity);
 	Memory(const Memory& rhs);
 	Memory& operator=(const Memory& rhs);
 	~Memory();
+	void Initialize(unsigned int capacity);
 	void Clear();
 
 	//___________Adding Memory Blocks to List_____________-
 	void AddHead(const unsigned int& size, bool used);
 	Block* SplitBlock(Block* blockToSplit, unsigned int size);
 
+	//___________Resizing Allocated Blocks in Place_____________
+	//Both return false and leave the list as it was if the block cannot be resized in place. Either may move the pool, so the Block* is not valid after
+	bool GrowBlock(Block* blockToGrow, unsigned int size);
+	bool ShrinkBlock(Block* blockToShrink, unsigned int size);
+
 	//___________Compacting Algorithms to Free Space____________
 	Block* CompactLeft(Block* blockToCompact);
 	Block* CompactRight(Block* blockToCompact);
 
+	//____________Walking the List____________
+	//Return nullptr at the ends of the list
+	Block* Next(Block* block);
+	Block* Prev(Block* block);
+	uint64_t* GetData(Block* block);
+
 	//____________Algorithms to Find Blocks/Bits of List____________
 	Block* FindByOffset(const unsigned int& offset);
 	Block* FindByData(const uint64_t* dataToFind);
@@ -53,14 +70,50 @@ public:
 
 	//____________Getters_____________
 	unsigned int GetCapacity();
+	uint64_t* GetArena();
+	const std::map<unsigned int, unsigned int>& GetHoles();
+	//Kept up to date by every split, fill, free and compaction, so reading them does not walk the holes
+	uint64_t GetFreeWords();
+	unsigned int GetHoleCount();
+	unsigned int GetLargestHole();
+	const std::vector<uint64_t>& GetOccupancy();
 
 	//____________Modifiers___________
 	void FillBlock(Block* blockToFill);
+	void FreeBlock(Block* blockToFree);
+	void SetEngine(AllocatorEngine* engine);
 	
 private:
+	void CopyArena(const Memory& rhs);
+	void IndexBlock(uint32_t index);
+	uint32_t NewBlock(unsigned int size, bool used, unsigned int offset);
+	void UnlinkBlock(uint32_t index);
+	Block* At(uint32_t index);
+	uint32_t IndexOf(Block* block);
+	void AddHole(unsigned int offset, unsigned int size);
+	void RemoveHole(unsigned int offset);
+	void RebuildHoles();
+	void SetOccupancy(unsigned int offset, unsigned int size, bool used);
+
+	uint64_t* arena;
+	//Every block record, linked into the list by index. Records unlinked by a compaction are chained through next from freeBlocks and reused by the next split
+	std::vector<Block> blocks;
+	uint32_t freeBlocks;
+	//blockIndex[offset] is the pool index of the block starting at that word offset, or NO_BLOCK if no block starts there
+	std::vector<uint32_t> blockIndex;
+	//Offset -> size of every free block, kept in address order as blocks are split, filled, freed and compacted
+	//Size -> number of free blocks of that size, so the largest hole is the last key
+	//An attached engine keeps its own index of the holes, so these are only kept while there is no engine
+	std::map<unsigned int, unsigned int> holes;
+	std::map<unsigned int, unsigned int> holeSizes;
+	uint64_t freeWords;
+	unsigned int holeCount;
+	AllocatorEngine* engine;
+	//Packed bitmap of allocated words, kept up to date as blocks are filled and freed
+	std::vector<uint64_t> occupancy;
 	uint64_t* listData;
 	unsigned int listSize;
-	Block* head;
-	Block* tail;
+	uint32_t head;
+	uint32_t tail;
 	unsigned int memory_capacity;
 };
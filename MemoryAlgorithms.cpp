@@ -1,4 +1,8 @@
 #include "MemoryAlgorithms.h"
+#include "BitOps.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 //______________________________________________________________________________Memory Algorithms_______________________________________________________________________________
 
@@ -12,13 +16,14 @@ int bestFit(int sizeInWords, void* list) {
 	}
 	else {
 		//Set offset to -1 by default, the first index in the array is the number of holes in the list 
+		//The minimum starts one past the largest 16-bit size so a hole of exactly 65,535 words can still be picked
 		uint16_t holeListlength = *holeList++;
-		uint16_t minVal = UINT16_MAX;
+		int minVal = UINT16_MAX + 1;
 		int offset = -1; 
 
 		//Each hole provides offset info and size info so the total size to loop through is (holListLength*2)
 		//We are looking at the hole size which is held in every odd index
-		for (uint16_t ii = 1; ii < (holeListlength) * 2; ii += 2) {
+		for (uint32_t ii = 1; ii < (holeListlength) * 2; ii += 2) {
 			//If a hole has a smaller size than the current minimum size and fits the sizeInWords we're trying to allocate 
 			//Then set the new offset to holeList[ii-1] (offsets stored before hole size in the list) and the minVal to the holeSize at current index
 			if (holeList[ii] < minVal && sizeInWords <= holeList[ii]) {
@@ -47,7 +52,7 @@ int worstFit(int sizeInWords, void* list) {
 
 		//Each hole provides offset info and size info so the total size to loop through is (holListLength*2)
 		//We are looking at the hole size which is held in every odd index
-		for (uint16_t ii = 1; ii < (holeListlength) * 2; ii += 2) {
+		for (uint32_t ii = 1; ii < (holeListlength) * 2; ii += 2) {
 			//If a hole has a larger size than the current minimum size and fits the sizeInWords we're trying to allocate 
 			//Then set the new offset to holeList[ii-1] (offsets stored before hole size in the list) and the maxVal to the holeSize at current index
 			if (holeList[ii] > maxVal && sizeInWords <= holeList[ii]) {
@@ -58,4 +63,236 @@ int worstFit(int sizeInWords, void* list) {
 		//Returns offset
 		return offset;
 	}
-}
\ No newline at end of file
+}
+
+//Returns the first hole that fits the sizeInWords, the hole list is in address order so this is the hole with the lowest offset
+int firstFit(int sizeInWords, void* list) {
+	uint16_t* holeList = static_cast<uint16_t*>(list);
+
+	//If the holeList was nullptr, return -1
+	if (holeList == nullptr) {
+		return -1;
+	}
+	else {
+		//The first index in the array is the number of holes in the list 
+		uint16_t holeListlength = *holeList++;
+
+		//Return the offset of the first hole whose size (held in every odd index) fits the sizeInWords
+		for (uint32_t ii = 1; ii < (holeListlength) * 2; ii += 2) {
+			if (sizeInWords <= holeList[ii]) {
+				return (int)holeList[ii - 1];
+			}
+		}
+		//No hole fits
+		return -1;
+	}
+}
+
+//______________________________________________________________________________32-bit Memory Algorithms_______________________________________________________________________________
+//Returns the smallest hole that fits the sizeInWords, the first index in the array is the number of holes followed by the offset and size of each hole
+int64_t bestFit32(uint64_t sizeInWords, void* list) {
+	uint32_t* holeList = static_cast<uint32_t*>(list);
+	if (holeList == nullptr) {
+		return -1;
+	}
+	uint32_t holeListlength = *holeList++;
+	uint64_t minVal = UINT64_MAX;
+	int64_t offset = -1;
+	for (uint64_t ii = 1; ii < (uint64_t)holeListlength * 2; ii += 2) {
+		if (holeList[ii] < minVal && sizeInWords <= holeList[ii]) {
+			offset = holeList[ii - 1];
+			minVal = holeList[ii];
+		}
+	}
+	return offset;
+}
+
+//Returns the largest hole that fits the sizeInWords
+int64_t worstFit32(uint64_t sizeInWords, void* list) {
+	uint32_t* holeList = static_cast<uint32_t*>(list);
+	if (holeList == nullptr) {
+		return -1;
+	}
+	uint32_t holeListlength = *holeList++;
+	uint64_t maxVal = 0;
+	int64_t offset = -1;
+	for (uint64_t ii = 1; ii < (uint64_t)holeListlength * 2; ii += 2) {
+		if (holeList[ii] > maxVal && sizeInWords <= holeList[ii]) {
+			offset = holeList[ii - 1];
+			maxVal = holeList[ii];
+		}
+	}
+	return offset;
+}
+
+//Returns the hole with the lowest offset that fits the sizeInWords
+int64_t firstFit32(uint64_t sizeInWords, void* list) {
+	uint32_t* holeList = static_cast<uint32_t*>(list);
+	if (holeList == nullptr) {
+		return -1;
+	}
+	uint32_t holeListlength = *holeList++;
+	for (uint64_t ii = 1; ii < (uint64_t)holeListlength * 2; ii += 2) {
+		if (sizeInWords <= holeList[ii]) {
+			return holeList[ii - 1];
+		}
+	}
+	return -1;
+}
+
+//______________________________________________________________________________Hole View Memory Algorithms_______________________________________________________________________________
+//Returns the index of the first size equal to value, or count if there is none
+static uint32_t findFirstEqual(const uint32_t* sizes, uint32_t count, uint32_t value) {
+	uint32_t ii = 0;
+#ifdef __AVX2__
+	__m256i target = _mm256_set1_epi32((int)value);
+	for (; ii + 8 <= count; ii += 8) {
+		__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sizes + ii));
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, target)));
+		if (mask != 0) {
+			return ii + LowestSetBit((uint64_t)mask);
+		}
+	}
+#endif
+	for (; ii < count; ii += 1) {
+		if (sizes[ii] == value) {
+			return ii;
+		}
+	}
+	return count;
+}
+
+//Returns the smallest hole that fits the sizeInWords
+//The smallest fitting size is found first, holes that do not fit are compared as the largest 32-bit value which no hole can be, then its first hole is found
+int64_t bestFitView(uint64_t sizeInWords, const HoleView& holes) {
+	if (holes.count == 0 || sizeInWords >= UINT32_MAX) {
+		return -1;
+	}
+	uint32_t minVal = UINT32_MAX;
+	uint32_t ii = 0;
+#ifdef __AVX2__
+	__m256i need = _mm256_set1_epi32((int)sizeInWords);
+	__m256i ones = _mm256_set1_epi32(-1);
+	__m256i minimum = ones;
+	for (; ii + 8 <= holes.count; ii += 8) {
+		__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(holes.sizes + ii));
+		//A size fits when max(size, need) is the size
+		__m256i fits = _mm256_cmpeq_epi32(_mm256_max_epu32(block, need), block);
+		minimum = _mm256_min_epu32(minimum, _mm256_or_si256(block, _mm256_andnot_si256(fits, ones)));
+	}
+	uint32_t lanes[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), minimum);
+	for (unsigned int lane = 0; lane < 8; lane += 1) {
+		minVal = lanes[lane] < minVal ? lanes[lane] : minVal;
+	}
+#endif
+	for (; ii < holes.count; ii += 1) {
+		if (holes.sizes[ii] < minVal && sizeInWords <= holes.sizes[ii]) {
+			minVal = holes.sizes[ii];
+		}
+	}
+	if (minVal == UINT32_MAX) {
+		return -1;
+	}
+	return holes.offsets[findFirstEqual(holes.sizes, holes.count, minVal)];
+}
+
+//Returns the largest hole that fits the sizeInWords
+//Every hole fits if the largest one does, so the largest size is found without comparing against sizeInWords
+int64_t worstFitView(uint64_t sizeInWords, const HoleView& holes) {
+	if (holes.count == 0) {
+		return -1;
+	}
+	uint32_t maxVal = 0;
+	uint32_t ii = 0;
+#ifdef __AVX2__
+	__m256i maximum = _mm256_setzero_si256();
+	for (; ii + 8 <= holes.count; ii += 8) {
+		maximum = _mm256_max_epu32(maximum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(holes.sizes + ii)));
+	}
+	uint32_t lanes[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maximum);
+	for (unsigned int lane = 0; lane < 8; lane += 1) {
+		maxVal = lanes[lane] > maxVal ? lanes[lane] : maxVal;
+	}
+#endif
+	for (; ii < holes.count; ii += 1) {
+		maxVal = holes.sizes[ii] > maxVal ? holes.sizes[ii] : maxVal;
+	}
+	if (maxVal == 0 || sizeInWords > maxVal) {
+		return -1;
+	}
+	return holes.offsets[findFirstEqual(holes.sizes, holes.count, maxVal)];
+}
+
+//Returns the first hole that fits the sizeInWords
+int64_t firstFitView(uint64_t sizeInWords, const HoleView& holes) {
+	if (sizeInWords >= UINT32_MAX) {
+		return -1;
+	}
+	uint32_t ii = 0;
+#ifdef __AVX2__
+	__m256i need = _mm256_set1_epi32((int)sizeInWords);
+	for (; ii + 8 <= holes.count; ii += 8) {
+		__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(holes.sizes + ii));
+		__m256i fits = _mm256_cmpeq_epi32(_mm256_max_epu32(block, need), block);
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(fits));
+		if (mask != 0) {
+			return holes.offsets[ii + LowestSetBit((uint64_t)mask)];
+		}
+	}
+#endif
+	for (; ii < holes.count; ii += 1) {
+		if (sizeInWords <= holes.sizes[ii]) {
+			return holes.offsets[ii];
+		}
+	}
+	return -1;
+}
+
+//______________________________________________________________________________16-bit Allocator Adapter_______________________________________________________________________________
+const int64_t Allocator16Adapter::TOO_MANY_HOLES;
+
+Allocator16Adapter::Allocator16Adapter(std::function<int(int, void*)> allocator) {
+	this->allocator = allocator;
+}
+
+int64_t Allocator16Adapter::operator()(uint64_t sizeInWords, void* list) {
+	uint32_t* holeList32 = static_cast<uint32_t*>(list);
+	if (holeList32 == nullptr || sizeInWords > UINT16_MAX) {
+		return -1;
+	}
+
+	//Each hole is given to the allocator as (index, size capped at 16 bits)
+	uint32_t holes = holeList32[0];
+	if (holes > INT16_MAX) {
+		return TOO_MANY_HOLES;
+	}
+	holeList.clear();
+	holeList.push_back(holes);
+	for (uint32_t ii = 0; ii < holes; ii += 1) {
+		uint32_t size = holeList32[(ii * 2) + 2];
+		holeList.push_back(ii);
+		holeList.push_back(size < UINT16_MAX ? size : UINT16_MAX);
+	}
+
+	//The index the allocator returns is turned back into the offset of that hole
+	int index = allocator((int)sizeInWords, holeList.data());
+	if (index < 0 || (uint32_t)index >= holes) {
+		return -1;
+	}
+	return holeList32[(index * 2) + 1];
+}
+std::function<int64_t(uint64_t, void*)> allocator32For(std::function<int(int, void*)> allocator) {
+	int (* const* function)(int, void*) = allocator.target<int(*)(int, void*)>();
+	if (function != nullptr && *function == bestFit) {
+		return bestFit32;
+	}
+	if (function != nullptr && *function == worstFit) {
+		return worstFit32;
+	}
+	if (function != nullptr && *function == firstFit) {
+		return firstFit32;
+	}
+	return Allocator16Adapter(allocator);
+}
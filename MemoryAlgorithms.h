@@ -1,9 +1,45 @@
 #pragma once
+#include <functional>
+#include <vector>
+#include <stdint.h>
 #include "MemoryManager.h"
+#include "HoleView.h"
 
 //Declares global memory algorithm functions
 #ifndef Memory_Algorithm_Header
 #define Memory_Alorithm_Header
 int bestFit(int sizeInWords, void* list);
 int worstFit(int sizeInWords, void* list);
+int firstFit(int sizeInWords, void* list);
+
+//The same algorithms over the 32-bit hole list returned by getList32()
+int64_t bestFit32(uint64_t sizeInWords, void* list);
+int64_t worstFit32(uint64_t sizeInWords, void* list);
+int64_t firstFit32(uint64_t sizeInWords, void* list);
+
+//The same algorithms over the split hole arrays given by setHoleViewAllocator(). With AVX2 the sizes are compared 8 at a time
+//Ties go to the hole with the lowest offset, so they pick the same holes as the algorithms above
+int64_t bestFitView(uint64_t sizeInWords, const HoleView& holes);
+int64_t worstFitView(uint64_t sizeInWords, const HoleView& holes);
+int64_t firstFitView(uint64_t sizeInWords, const HoleView& holes);
+
+//Lets an allocator written for the 16-bit hole list choose from a 32-bit hole list. The allocator is given a 16-bit list where the offset
+//of each hole is its index in the 32-bit list and sizes above 16 bits are capped, and the index it returns is turned back into the offset
+//This works for any allocator that returns one of the offsets in its list, with sizes up to 65,535 words
+//A list of more than 32,767 holes returns TOO_MANY_HOLES instead of being cut short, so an allocator that walks the list with a 16-bit index
+//up to (holes * 2) never sees that bound wrap and no hole is silently left out
+class Allocator16Adapter {
+public:
+	static const int64_t TOO_MANY_HOLES = -2;
+
+	Allocator16Adapter(std::function<int(int, void*)> allocator);
+	int64_t operator()(uint64_t sizeInWords, void* list);
+
+private:
+	std::function<int(int, void*)> allocator;
+	std::vector<uint16_t> holeList;
+};
+
+//Returns the 32-bit version of bestFit, worstFit or firstFit, which sees every hole at its full size, or an Allocator16Adapter for any other allocator
+std::function<int64_t(uint64_t, void*)> allocator32For(std::function<int(int, void*)> allocator);
 #endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <stdint.h>
+
+//A memory backend replaces the Memory linked list as the store the manager allocates from. It does its own fitting, so the manager's allocator is not used
+//Offsets and sizes are in words, and every backend owns a contiguous arena the data it returns points into
+class MemoryBackend {
+public:
+	virtual ~MemoryBackend() {}
+
+	//___________Creating and Deleting the Arena______________
+	virtual void Initialize(unsigned int capacity) = 0;
+	virtual void Clear() = 0;
+
+	//___________Allocating and Freeing_____________
+	//Returns nullptr if no block of sizeInWords can be allocated
+	virtual uint64_t* Allocate(unsigned int sizeInWords) = 0;
+	//Pointers the backend did not return, or already freed, are ignored
+	virtual void Free(uint64_t* data) = 0;
+
+	//____________Representations of the Backend____________
+	virtual void FindFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v) = 0;
+	virtual void BitRepresentation(std::vector<int>& v) = 0;
+	virtual uint64_t* FindFilledBlocks() = 0;
+	//Backends that keep a packed bitmap of allocated words (Bit ii % 64 of element ii / 64) return it so getBitmap() can copy it directly
+	virtual const std::vector<uint64_t>* GetPackedBitmap() { return nullptr; }
+
+	//____________Getters_____________
+	virtual unsigned int GetCapacity() = 0;
+	//The words every allocation points into, or nullptr before Initialize
+	virtual uint64_t* GetArena() = 0;
+	//Words allocated beyond what was requested
+	virtual unsigned long long GetInternalFragmentation() = 0;
+	//Words the block at data holds for its caller, or 0 if data is not the start of an allocated block
+	virtual unsigned int GetBlockSize(uint64_t* data) = 0;
+};
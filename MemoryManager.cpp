@@ -1,4 +1,5 @@
 #include "MemoryManager.h"
+#include <cstring>
 
 
 //_____________________________________________________________________________________________________Memory Manager________________________________________________________________________________________________
@@ -9,6 +10,25 @@ MemoryManager::MemoryManager(unsigned wordSize, std::function<int(int, void*)> a
 	Memory temp(0);
 	memory = temp;
 	this->allocator = allocator;
+	adaptedAllocator = allocator32For(allocator);
+	allocator32 = nullptr;
+	holeViewAllocator = nullptr;
+	engine = nullptr;
+	backend = nullptr;
+}
+
+//Constructor which sets the wordSize and an allocator engine that searches its own hole index (The engine is not owned by the manager)
+MemoryManager::MemoryManager(unsigned wordSize, AllocatorEngine* engine) {
+	this->wordSize = wordSize;
+	capacity = 0;
+	Memory temp(0);
+	memory = temp;
+	allocator = nullptr;
+	adaptedAllocator = nullptr;
+	allocator32 = nullptr;
+	holeViewAllocator = nullptr;
+	this->engine = engine;
+	backend = nullptr;
 }
 
 MemoryManager::~MemoryManager() {
@@ -17,12 +37,18 @@ MemoryManager::~MemoryManager() {
 	memory.Clear();
 }
 
-//Creates a free block of memory with a word capacity of sizeInWords, which can hold a byte capacity of sizeInWords*wordSize as long as its below the maximum word size of 65,536
+//Creates a free block of memory with a word capacity of sizeInWords, which can hold a byte capacity of sizeInWords*wordSize
+//Offsets and sizes are 32-bit words, with the largest 32-bit value kept free to end the free lists of the engines and backends
 void MemoryManager::initialize(size_t sizeInWords) {
-	if (sizeInWords <= 65536) {
+	if (sizeInWords < UINT32_MAX) {
 		capacity = sizeInWords * wordSize;
-		Memory temp(sizeInWords);
-		memory = temp;
+		//A backend replaces the linked list, so only the backend is created
+		if (backend != nullptr) {
+			backend->Initialize(sizeInWords);
+			return;
+		}
+		memory.Initialize(sizeInWords);
+		memory.SetEngine(engine);
 		memory.AddHead(sizeInWords, false);
 	}
 }
@@ -31,12 +57,28 @@ void MemoryManager::initialize(size_t sizeInWords) {
 void MemoryManager::shutdown() {
 	capacity = 0;
 	memory.Clear();
+	if (backend != nullptr) {
+		backend->Clear();
+	}
 }
 
 //Allocates memory into any free space left in the memory block
 void* MemoryManager::allocate(size_t sizeInBytes) {
+	MEMORY_TIME_SCOPE(ALLOCATE);
 	//Convert the size in bytes to wsize in words
-	int sizeInWords = sizeInBytes / wordSize;
+	//Every block needs at least 1 word, so a request smaller than a word gets 1 word as it does from the engines and backends
+	size_t sizeInWords = sizeInBytes / wordSize;
+	if (sizeInWords == 0) {
+		sizeInWords = 1;
+	}
+
+	//A backend does its own fitting
+	if (backend != nullptr) {
+		if (backend->GetCapacity() == 0 || sizeInWords > backend->GetCapacity()) {
+			return nullptr;
+		}
+		return backend->Allocate(sizeInWords);
+	}
 
 	//If our memory has a capacity of 0 or we are trying to allocate more memory than we can hold in our block then return nullptr
 	if (memory.GetCapacity() == 0 || sizeInWords > memory.GetCapacity()) {
@@ -46,54 +88,212 @@ void* MemoryManager::allocate(size_t sizeInBytes) {
 	//Otherwise, get the offset of the block to allocate using the allocator
 	//If the offset is -1, no free block fo the correct size was found so return nullptr
 	else {
-		uint16_t* list = static_cast<uint16_t*>(getList());
-		int offset = allocator(sizeInWords, list);
-		delete[] list;
-		if (offset == -1) {
-			return nullptr;
-		}
+		return allocateAt(findHole(sizeInWords), sizeInWords);
+	}
+}
 
-		//If the offset is a proper offset, find the corresponding block using its offset
-		Memory::Block* block = memory.FindByOffset(offset);
+//Returns the offset of the hole to allocate sizeInWords from, or -1 if there is none
+//An engine searches its own hole index. Otherwise the allocator scans the hole list, which is filled from the holes the memory list keeps up to date into a buffer reused by every allocation
+//A 16-bit allocator is given the 16-bit hole list while every offset and size fits in 16 bits. On larger heaps bestFit, worstFit and firstFit
+//are replaced by their 32-bit versions and any other allocator goes through the adapter
+//The hole list is built before the scan starts so the instrumentation can time the two apart
+int64_t MemoryManager::findHole(size_t sizeInWords) {
+	if (engine != nullptr) {
+		MEMORY_TIME_SCOPE(ALLOCATOR_SCAN);
+		return engine->FindHole(sizeInWords);
+	}
+	else if (allocator32 != nullptr) {
+		uint32_t* list = fillHoleList32();
+		MEMORY_TIME_SCOPE(ALLOCATOR_SCAN);
+		MEMORY_COUNT(HOLES_SCANNED, memory.GetHoleCount());
+		return allocator32(sizeInWords, list);
+	}
+	else if (holeViewAllocator != nullptr) {
+		HoleView view = fillHoleView();
+		MEMORY_TIME_SCOPE(ALLOCATOR_SCAN);
+		MEMORY_COUNT(HOLES_SCANNED, view.count);
+		return holeViewAllocator(sizeInWords, view);
+	}
+	else if (memory.GetCapacity() <= UINT16_MAX) {
+		uint16_t* list = fillHoleList();
+		MEMORY_TIME_SCOPE(ALLOCATOR_SCAN);
+		MEMORY_COUNT(HOLES_SCANNED, memory.GetHoleCount());
+		return allocator(sizeInWords, list);
+	}
+	else {
+		uint32_t* list = fillHoleList32();
+		MEMORY_TIME_SCOPE(ALLOCATOR_SCAN);
+		MEMORY_COUNT(HOLES_SCANNED, memory.GetHoleCount());
+		return adaptedAllocator(sizeInWords, list);
+	}
+}
 
-		//If the block is the exact size we need, simply fill it and return the data. 
-		if (block->getSize() == sizeInWords) {
-			memory.FillBlock(block);
-			return block->getData();
-		}
-		//Otherwise, split the block into the portion to be filled and the portion that remains free and return the data
-		else {
-			Memory::Block* temp = memory.SplitBlock(block, sizeInWords);
-			return temp->getData();
+//Allocates sizeInWords at the start of the hole at offset, or returns nullptr if the allocator found no hole (offset is -1) or failed (any other negative offset)
+void* MemoryManager::allocateAt(int64_t offset, size_t sizeInWords) {
+	if (offset < 0) {
+		return nullptr;
+	}
+
+	//If the offset is a proper offset, find the corresponding block using its offset
+	//The lookup is O(1), so an allocator that returns an offset which is not the start of a hole big enough is also caught here
+	Memory::Block* block;
+	{
+		MEMORY_TIME_SCOPE(FIND_BLOCK);
+		block = memory.FindByOffset(offset);
+	}
+	if (block == nullptr || block->getUsedStatus() || block->getSize() < sizeInWords) {
+		return nullptr;
+	}
+
+	//If the block is the exact size we need, simply fill it and return the data. 
+	if (block->getSize() == sizeInWords) {
+		memory.FillBlock(block);
+		return memory.GetData(block);
+	}
+	//Otherwise, split the block into the portion to be filled and the portion that remains free and return the data
+	else {
+		Memory::Block* temp = memory.SplitBlock(block, sizeInWords);
+		if (temp == nullptr) {
+			return nullptr;
 		}
+		return memory.GetData(temp);
 	}
 }
 
 //Frees space that is requested
 void MemoryManager::free(void* address) {
+	MEMORY_TIME_SCOPE(FREE);
 	//Data is passed in, find the block it corresponds to
 	uint64_t* currentAddress = static_cast<uint64_t*>(address);
-	Memory::Block* currentBlock = memory.FindByData(currentAddress);
+	if (backend != nullptr) {
+		backend->Free(currentAddress);
+		return;
+	}
+	Memory::Block* currentBlock;
+	{
+		MEMORY_TIME_SCOPE(FIND_BLOCK);
+		currentBlock = memory.FindByData(currentAddress);
+	}
 	if (currentBlock != nullptr) {
 		if (currentBlock->getUsedStatus()) {
 			//Free the block, if the right or left blocks relative to the current block are also free then call the CompactRight or CompactLeft algorithms respectively to compact the space into one large free block
-			currentBlock->set_block_status(false);
-			if (currentBlock->next != nullptr && !currentBlock->next->getUsedStatus()) {
+			memory.FreeBlock(currentBlock);
+			if (memory.Next(currentBlock) != nullptr && !memory.Next(currentBlock)->getUsedStatus()) {
+				MEMORY_COUNT(COALESCES, 1);
 				currentBlock = memory.CompactRight(currentBlock);
 			}
-			if (currentBlock->prev != nullptr && !currentBlock->prev->getUsedStatus()) {
+			if (memory.Prev(currentBlock) != nullptr && !memory.Prev(currentBlock)->getUsedStatus()) {
+				MEMORY_COUNT(COALESCES, 1);
 				currentBlock = memory.CompactLeft(currentBlock);
 			}
 		}
 	}
 }
 
+void* MemoryManager::reallocate(void* address, size_t sizeInBytes) {
+	if (address == nullptr) {
+		return allocate(sizeInBytes);
+	}
+	size_t sizeInWords = sizeInBytes / wordSize;
+	if (sizeInWords == 0) {
+		free(address);
+		return nullptr;
+	}
+
+	//A backend's blocks are only resized by moving them
+	uint64_t* currentAddress = static_cast<uint64_t*>(address);
+	size_t oldSizeInWords = 0;
+	if (backend != nullptr) {
+		oldSizeInWords = backend->GetBlockSize(currentAddress);
+	}
+	else {
+		Memory::Block* currentBlock = memory.FindByData(currentAddress);
+		if (currentBlock == nullptr || !currentBlock->getUsedStatus()) {
+			return nullptr;
+		}
+		oldSizeInWords = currentBlock->getSize();
+		if (sizeInWords == oldSizeInWords) {
+			return address;
+		}
+		//Resizing in place edits the blocks on either side of the block's end, the words in it stay where they are
+		if (sizeInWords < oldSizeInWords && memory.ShrinkBlock(currentBlock, sizeInWords)) {
+			return address;
+		}
+		if (sizeInWords > oldSizeInWords && sizeInWords <= memory.GetCapacity() && memory.GrowBlock(currentBlock, sizeInWords)) {
+			return address;
+		}
+	}
+	if (oldSizeInWords == 0) {
+		return nullptr;
+	}
+
+	//Every word is 64 bits in the arena, so that is what is copied whatever the word size
+	void* moved = allocate(sizeInBytes);
+	if (moved == nullptr) {
+		return nullptr;
+	}
+	memcpy(moved, address, (sizeInWords < oldSizeInWords ? sizeInWords : oldSizeInWords) * sizeof(uint64_t));
+	free(address);
+	return moved;
+}
+
 //Sets the allocator to a new function
 void MemoryManager::setAllocator(std::function<int(int, void*)> allocator) {
 	this->allocator = allocator;
+	adaptedAllocator = allocator32For(allocator);
+	allocator32 = nullptr;
+	holeViewAllocator = nullptr;
+	engine = nullptr;
+	memory.SetEngine(nullptr);
+}
+
+//Sets the allocator to a function which takes the 32-bit hole list
+void MemoryManager::setAllocator32(std::function<int64_t(uint64_t, void*)> allocator) {
+	this->allocator = nullptr;
+	adaptedAllocator = nullptr;
+	allocator32 = allocator;
+	holeViewAllocator = nullptr;
+	engine = nullptr;
+	memory.SetEngine(nullptr);
+}
+
+//Sets the allocator to a function which takes the holes as separate offset and size arrays
+void MemoryManager::setHoleViewAllocator(std::function<int64_t(uint64_t, const HoleView&)> allocator) {
+	this->allocator = nullptr;
+	adaptedAllocator = nullptr;
+	allocator32 = nullptr;
+	holeViewAllocator = allocator;
+	engine = nullptr;
+	memory.SetEngine(nullptr);
+}
+
+//Replaces the linked list with a backend that does its own fitting, or goes back to the linked list if backend is nullptr
+//The backend is not owned by the manager and is created by the next call to initialize
+void MemoryManager::setBackend(MemoryBackend* backend) {
+	this->backend = backend;
+}
+
+//Sets the allocator to an engine, which indexes the holes the list has now and every hole it gains or loses after
+void MemoryManager::setAllocator(AllocatorEngine* engine) {
+	allocator = nullptr;
+	adaptedAllocator = nullptr;
+	allocator32 = nullptr;
+	holeViewAllocator = nullptr;
+	this->engine = engine;
+	memory.SetEngine(engine);
 }
 
 int MemoryManager::dumpMemoryMap(char* filename) {
+	//Get the buffer and bufferSize from getBuffer()
+	unsigned int bufferSize = 0;
+	char* bufferToWrite = getBuffer(bufferSize);
+	int status = writeMemoryMap(filename, bufferToWrite, bufferSize);
+	delete[] bufferToWrite;
+	return status;
+}
+
+//Writes a buffer from getBuffer() or formatHoles() to a file, returns 0 if successful and -1 otherwise
+int MemoryManager::writeMemoryMap(char* filename, char* buffer, unsigned int bufferSize) {
 	//Each file has a unique file number (fd). Open file and get this file number
 	int fd;
 	mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
@@ -104,16 +304,12 @@ int MemoryManager::dumpMemoryMap(char* filename) {
 		return -1;
 	}
 
-	//Get the buffer and bufferSize from getBuffer()
-	unsigned int bufferSize = 0;
-	char* bufferToWrite = getBuffer(bufferSize);
-
-	//Write our buffer to the file and delete the buffer
-	ssize_t ret = write(fd, bufferToWrite, bufferSize);
-	delete[] bufferToWrite;
+	//Write our buffer to the file
+	ssize_t ret = write(fd, buffer, bufferSize);
 
 	//Write will return -1 if there is an error when writing
 	if (ret == -1) {
+		close(fd);
 		return -1;
 	}
 
@@ -127,10 +323,75 @@ int MemoryManager::dumpMemoryMap(char* filename) {
 	return 0;
 }
 
+//Gets the holes from the backend if there is one, otherwise from the linked list
+void MemoryManager::findFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v) {
+	if (backend != nullptr) {
+		backend->FindFreeBlocks(v);
+	}
+	else {
+		memory.FindFreeBlocks(v);
+	}
+}
+
+//Fills the reusable hole list buffer in the same format getList() returns, or returns nullptr if there are no holes
+uint16_t* MemoryManager::fillHoleList() {
+	MEMORY_TIME_SCOPE(HOLE_LIST_BUILD);
+	const std::map<unsigned int, unsigned int>& holes = memory.GetHoles();
+	MEMORY_COUNT(LIST_NODES_VISITED, holes.size());
+	if (holes.empty()) {
+		return nullptr;
+	}
+	holeList.clear();
+	holeList.reserve((holes.size() * 2) + 1);
+	holeList.push_back(holes.size());
+	for (std::map<unsigned int, unsigned int>::const_iterator it = holes.begin(); it != holes.end(); ++it) {
+		holeList.push_back(it->first);
+		holeList.push_back(it->second);
+	}
+	return holeList.data();
+}
+
+//Fills the reusable 32-bit hole list buffer in the same format getList32() returns, or returns nullptr if there are no holes
+uint32_t* MemoryManager::fillHoleList32() {
+	MEMORY_TIME_SCOPE(HOLE_LIST_BUILD);
+	const std::map<unsigned int, unsigned int>& holes = memory.GetHoles();
+	MEMORY_COUNT(LIST_NODES_VISITED, holes.size());
+	if (holes.empty()) {
+		return nullptr;
+	}
+	holeList32.clear();
+	holeList32.reserve((holes.size() * 2) + 1);
+	holeList32.push_back(holes.size());
+	for (std::map<unsigned int, unsigned int>::const_iterator it = holes.begin(); it != holes.end(); ++it) {
+		holeList32.push_back(it->first);
+		holeList32.push_back(it->second);
+	}
+	return holeList32.data();
+}
+
+//Fills the reusable offset and size arrays from the holes the memory list keeps up to date
+HoleView MemoryManager::fillHoleView() {
+	MEMORY_TIME_SCOPE(HOLE_LIST_BUILD);
+	const std::map<unsigned int, unsigned int>& holes = memory.GetHoles();
+	MEMORY_COUNT(LIST_NODES_VISITED, holes.size());
+	holeOffsets.clear();
+	holeSizes.clear();
+	for (std::map<unsigned int, unsigned int>::const_iterator it = holes.begin(); it != holes.end(); ++it) {
+		holeOffsets.push_back(it->first);
+		holeSizes.push_back(it->second);
+	}
+	HoleView view;
+	view.count = holeOffsets.size();
+	view.offsets = holeOffsets.data();
+	view.sizes = holeSizes.data();
+	return view;
+}
+
+//The 16-bit hole list, only exact while every offset and size fits in 16 bits. Use getList32() for larger heaps
 void* MemoryManager::getList() {
 	//Gets all the holes from our linked list memory manager
 	std::vector<std::pair<unsigned int, unsigned int>> v;
-	memory.FindFreeBlocks(v);
+	findFreeBlocks(v);
 	//If the size of our vector is 0, we found no holes so return nullptr
 	if (v.size() == 0) {
 		return nullptr;
@@ -157,55 +418,87 @@ void* MemoryManager::getList() {
 }
 
 
-void* MemoryManager::getBitmap() {
-	//Gets a representation of our linked list in bits (1 for used and 0 for empty);
-	std::vector<int> v;
-	memory.BitRepresentation(v);
-
-	//We must look at bytes so loop through increments of 8 bits and store them
-	std::vector<unsigned int> byteStream; 
-	for (unsigned int ii = 0; ii < v.size(); ii += 8) {
-		std::string byte;
-		for (unsigned int jj = ii; jj < (ii + 8); jj += 1) {
-			if (v.at(jj) == 1) {
-				byte.push_back('1');
-			}
-			else {
-				byte.push_back('0');
-			}
-			if (jj + 1 == v.size()) {
-				break;
+//The same list as getList() with 32-bit entries: the number of holes, then the offset and size of each hole
+void* MemoryManager::getList32() {
+	std::vector<std::pair<unsigned int, unsigned int>> v;
+	findFreeBlocks(v);
+	if (v.size() == 0) {
+		return nullptr;
+	}
+	uint32_t* list = new uint32_t[(v.size() * 2) + 1];
+	list[0] = v.size();
+	unsigned int index = 1;
+	for (unsigned int ii = 0; ii < v.size(); ii += 1) {
+		list[index] = v.at(ii).first;
+		list[index + 1] = v.at(ii).second;
+		index += 2;
+	}
+	return list;
+}
+
+//Builds a bitmap of allocated words, where word ii is bit (ii % 8) of byte (ii / 8), after a header holding the number of bytes in headerBytes bytes, lowest byte first
+//The linked list keeps a packed bitmap up to date, so its bytes are copied in one go. Backends give one int per word which is packed here
+uint8_t* MemoryManager::buildBitmap(unsigned int headerBytes) {
+	std::vector<uint8_t> packed;
+	const uint8_t* bytes;
+	size_t length;
+	//The Memory list and bitmap backends keep a packed bitmap that is copied directly, other backends are packed from their bit representation
+	const std::vector<uint64_t>* occupancy = getPackedBitmap();
+	size_t words = backend == nullptr ? memory.GetCapacity() : backend->GetCapacity();
+	if (occupancy != nullptr) {
+		bytes = reinterpret_cast<const uint8_t*>(occupancy->data());
+		length = (words + 7) / 8;
+	}
+	else {
+		std::vector<int> v;
+		backend->BitRepresentation(v);
+		packed.assign((v.size() + 7) / 8, 0);
+		for (size_t ii = 0; ii < v.size(); ii += 1) {
+			if (v[ii] == 1) {
+				packed[ii / 8] |= (1 << (ii % 8));
 			}
 		}
-		//Converts every 8 bits (byte) into a decimal and store it in our byteStream
-		unsigned int val = BinaryConvertor(byte);
-		byteStream.push_back(val);
+		bytes = packed.data();
+		length = packed.size();
 	}
 
-	//The size of the bitMap will be the number of bytes plus 2 to represent the size of our bitMap
-	unsigned int length = byteStream.size()+2;
-	uint8_t* bitMap = new uint8_t[length];
-
-	//The size is represented in 2 bytes, where 1 byte has a decimal value of 255
-	//If the size is less than 255, then the first byte represents the size and the second will be 0
-	if (byteStream.size() <= 255) {
-		bitMap[0] = byteStream.size();
-		bitMap[1] = 0;
+	uint8_t* bitMap = new uint8_t[length + headerBytes];
+	for (unsigned int ii = 0; ii < headerBytes; ii += 1) {
+		bitMap[ii] = (length >> (8 * ii)) & 0xFF;
 	}
-	//If the size is more than 255, than the first byte is 255 and the second will be the size % 256
-	else {
-		bitMap[0] = 255;
-		bitMap[1] = byteStream.size() % 256;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	//The packed bitmap is 64-bit elements, so on a big endian machine its bytes are taken out one at a time
+	if (occupancy != nullptr) {
+		for (size_t ii = 0; ii < length; ii += 1) {
+			bitMap[headerBytes + ii] = ((*occupancy)[ii / 8] >> (8 * (ii % 8))) & 0xFF;
+		}
+		bytes = bitMap + headerBytes;
+	}
+#endif
+	if (length != 0 && bytes != bitMap + headerBytes) {
+		memcpy(bitMap + headerBytes, bytes, length);
 	}
-	//Now that we have stored the size, fill our bitMap with the elements of the byteStream, then return the bitMap
-	unsigned int index = 2;
-	for (int ii = 0; ii < byteStream.size(); ii += 1) {
-		bitMap[index] = byteStream.at(ii);
-		index += 1;
+	//A packed bitmap may mark the bits past the capacity, so they are cleared from the last byte
+	if (occupancy != nullptr && words % 8 != 0) {
+		bitMap[headerBytes + length - 1] &= (1 << (words % 8)) - 1;
 	}
 	return bitMap;
 }
 
+//The size is represented in 2 bytes. Use getBitmap32() if the size does not fit in 16 bits
+void* MemoryManager::getBitmap() {
+	return buildBitmap(2);
+}
+
+//The same bitmap as getBitmap() with the size represented in 4 bytes
+void* MemoryManager::getBitmap32() {
+	return buildBitmap(4);
+}
+
+const std::vector<uint64_t>* MemoryManager::getPackedBitmap() {
+	return backend == nullptr ? &memory.GetOccupancy() : backend->GetPackedBitmap();
+}
+
 //Returns the wordSize
 unsigned MemoryManager::getWordSize() {
 	return wordSize;
@@ -213,14 +506,45 @@ unsigned MemoryManager::getWordSize() {
 
 //Finds all the allocated memory and collects its data to place in an array. Returns the data array.
 void* MemoryManager::getMemoryStart() {
+	if (backend != nullptr) {
+		return backend->FindFilledBlocks();
+	}
 	return memory.FindFilledBlocks();
 }
 
 //Returns the capacity of the list
-unsigned MemoryManager::getMemoryLimit() {
+size_t MemoryManager::getMemoryLimit() {
 	return capacity;
 }
 
+//Returns the bytes allocated beyond what was requested, which only a backend that rounds sizes up (Such as the buddy system) has
+unsigned long long MemoryManager::getInternalFragmentation() {
+	if (backend != nullptr) {
+		return backend->GetInternalFragmentation() * wordSize;
+	}
+	return 0;
+}
+
+MemoryManager::Stats MemoryManager::getStats() {
+	Stats stats = { 0, 0, 0, 0 };
+	if (backend != nullptr) {
+		std::vector<std::pair<unsigned int, unsigned int>> v;
+		backend->FindFreeBlocks(v);
+		stats.holes = v.size();
+		for (size_t ii = 0; ii < v.size(); ii += 1) {
+			stats.freeWords += v[ii].second;
+			stats.largestHole = v[ii].second > stats.largestHole ? v[ii].second : stats.largestHole;
+		}
+	}
+	else {
+		stats.freeWords = memory.GetFreeWords();
+		stats.holes = memory.GetHoleCount();
+		stats.largestHole = memory.GetLargestHole();
+	}
+	stats.externalFragmentation = stats.freeWords == 0 ? 0 : 1.0 - ((double)stats.largestHole / stats.freeWords);
+	return stats;
+}
+
 unsigned int MemoryManager::BinaryConvertor(std::string& byte) {
 	int val = 0;
 	int power = 0;
@@ -243,7 +567,17 @@ unsigned int MemoryManager::BinaryConvertor(std::string& byte) {
 char* MemoryManager::getBuffer(unsigned int& bufferSize) {
 	//Get all the hole offsets and sizes
 	std::vector<std::pair<unsigned int, unsigned int>> v;
-	memory.FindFreeBlocks(v);
+	findFreeBlocks(v);
+	return formatHoles(v, bufferSize);
+}
+
+//Formats holes as "[offset, size] - [offset, size]"
+char* MemoryManager::formatHoles(const std::vector<std::pair<unsigned int, unsigned int>>& v, unsigned int& bufferSize) {
+	//If there are no holes the buffer is empty
+	if (v.size() == 0) {
+		bufferSize = 0;
+		return new char[1];
+	}
 
 	//Place all hole offsets and sizes into a properly formatted string
 	std::string sbuffer;
@@ -277,3 +611,11 @@ char* MemoryManager::getBuffer(unsigned int& bufferSize) {
 	}
 	return cbuffer;
 }
+
+//Returns the words every allocation points into, from the backend if there is one
+void* MemoryManager::getArena() {
+	if (backend != nullptr) {
+		return backend->GetArena();
+	}
+	return memory.GetArena();
+}
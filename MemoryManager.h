@@ -1,5 +1,5 @@
 #pragma once
-//#include <unistd.h>
+#include <unistd.h>
 #include <fcntl.h>
 #include <iostream>
 #include <functional>
@@ -7,27 +7,82 @@
 #include <string>
 #include "Memory.h"
 #include "MemoryAlgorithms.h"
+#include "HoleView.h"
+#include "Instrumentation.h"
+#include "AllocatorEngine.h"
+#include "TlsfEngine.h"
+#include "MemoryBackend.h"
+#include "BuddyMemory.h"
+#include "BitmapMemory.h"
 
 class MemoryManager {
 public:
+	//Free space of the heap. externalFragmentation is 1 - (largestHole / freeWords), which is 0 when all the free words are in one hole or none are free
+	struct Stats {
+		uint64_t freeWords;
+		uint64_t holes;
+		uint64_t largestHole;
+		double externalFragmentation;
+	};
+
 	MemoryManager(unsigned wordSize, std::function<int(int, void*)> allocator);
-	~MemoryManager();
+	MemoryManager(unsigned wordSize, AllocatorEngine* engine);
+	virtual ~MemoryManager();
 	void initialize(size_t sizeInWords);
 	void shutdown();
 	void* allocate(size_t sizeInBytes);
 	void free(void* address);
+	//Resizes the block at address keeping the words both sizes hold. Grows into a free block right after it and shrinks by freeing its tail in place,
+	//otherwise moves the words to a new block. Returns nullptr and leaves the block as it was if no block of sizeInBytes can be found
+	//As with realloc a nullptr address allocates, and a size of 0 frees and returns nullptr
+	void* reallocate(void* address, size_t sizeInBytes);
 	void setAllocator(std::function<int(int, void*)> allocator);
+	void setAllocator(AllocatorEngine* engine);
+	void setAllocator32(std::function<int64_t(uint64_t, void*)> allocator);
+	void setHoleViewAllocator(std::function<int64_t(uint64_t, const HoleView&)> allocator);
+	void setBackend(MemoryBackend* backend);
 	int dumpMemoryMap(char* filename);
+	static int writeMemoryMap(char* filename, char* buffer, unsigned int bufferSize);
 	void* getList();
+	void* getList32();
 	void* getBitmap();
+	void* getBitmap32();
+	//Bit (ii % 64) of element (ii / 64) is 1 if word ii is allocated, or nullptr if the backend keeps no packed bitmap. Bits past the capacity may be set
+	const std::vector<uint64_t>* getPackedBitmap();
 	unsigned getWordSize();
 	void* getMemoryStart();
-	unsigned getMemoryLimit();
+	size_t getMemoryLimit();
+	unsigned long long getInternalFragmentation();
+	//Reads counters the block list keeps as it splits and compacts, so it does not build a hole list. Backends are walked for their holes
+	Stats getStats();
 	unsigned int BinaryConvertor(std::string& byte);
 	char* getBuffer(unsigned int& bufferSize);
+	static char* formatHoles(const std::vector<std::pair<unsigned int, unsigned int>>& v, unsigned int& bufferSize);
+	void* getArena();
+protected:
+	//The search allocate() runs once the size is checked against the capacity. Subclasses override it to search their own way,
+	//and since allocate() is not virtual it also reaches them through a MemoryManager reference, for one virtual call per allocation
+	virtual int64_t findHole(size_t sizeInWords);
+	void* allocateAt(int64_t offset, size_t sizeInWords);
+
+	Memory memory;
+	AllocatorEngine* engine;
+	MemoryBackend* backend;
 private:
-	unsigned capacity;
+	uint16_t* fillHoleList();
+	uint32_t* fillHoleList32();
+	HoleView fillHoleView();
+	uint8_t* buildBitmap(unsigned int headerBytes);
+	void findFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v);
+
+	size_t capacity;
 	unsigned wordSize;
-	Memory memory;
 	std::function<int(int, void*)> allocator;
+	std::function<int64_t(uint64_t, void*)> adaptedAllocator;
+	std::function<int64_t(uint64_t, void*)> allocator32;
+	std::function<int64_t(uint64_t, const HoleView&)> holeViewAllocator;
+	std::vector<uint16_t> holeList;
+	std::vector<uint32_t> holeList32;
+	std::vector<uint32_t> holeOffsets;
+	std::vector<uint32_t> holeSizes;
 };
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+#include "MemoryManager.h"
+
+//A memory manager whose fit strategy is fixed at compile time. Policy is an allocator engine type (Such as BestFitEngine) that the manager owns,
+//and its findHole() calls the policy's FindHole directly instead of through std::function or the virtual engine interface, so no hole list is built
+//BestFitEngine, WorstFitEngine and TlsfEngine define their searches in their headers, so the search is inlined into findHole()
+//allocate() reaches findHole() through one virtual call, so code holding a MemoryManager reference (SlabCache, TraceReplay) uses the policy too
+//The memory list still reports holes through the virtual InsertHole and EraseHole, so splits and coalesces cost the same as with MemoryManager
+//The runtime setters still work: once setAllocator() or setBackend() replaces the policy, allocate() goes through the MemoryManager path
+template <class Policy>
+class PolicyMemoryManager : public MemoryManager {
+public:
+	//The base only stores the address of policy, which is constructed before initialize() attaches it to the memory list
+	PolicyMemoryManager(unsigned wordSize) : MemoryManager(wordSize, &policy) {}
+	//The base would keep pointing at the policy of the manager it was copied from
+	PolicyMemoryManager(const PolicyMemoryManager& rhs) = delete;
+	PolicyMemoryManager& operator=(const PolicyMemoryManager& rhs) = delete;
+
+	//Puts the compile-time policy back after the runtime setters replaced it
+	void usePolicy() {
+		setAllocator(&policy);
+	}
+
+	Policy& getPolicy() {
+		return policy;
+	}
+
+protected:
+	//The qualified call is not virtual, so the compiler can inline the policy's search when it is visible
+	int64_t findHole(size_t sizeInWords) override {
+		if (engine != &policy) {
+			return MemoryManager::findHole(sizeInWords);
+		}
+		MEMORY_TIME_SCOPE(ALLOCATOR_SCAN);
+		return policy.Policy::FindHole(sizeInWords);
+	}
+
+private:
+	Policy policy;
+};
@@ -0,0 +1,233 @@
+#include "ShardedMemoryManager.h"
+#include <atomic>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+//_____________________________________________________________________________________________________Sharded Memory Manager________________________________________________________________________________________________
+ShardedMemoryManager::ShardedMemoryManager(unsigned wordSize, std::function<int(int, void*)> allocator, unsigned int shardCount, Assignment assignment) {
+	this->wordSize = wordSize;
+	this->assignment = assignment;
+	capacity = 0;
+	if (shardCount == 0) {
+		shardCount = 1;
+	}
+	for (unsigned int ii = 0; ii < shardCount; ii += 1) {
+		shards.push_back(new Shard(wordSize, allocator));
+	}
+}
+
+ShardedMemoryManager::~ShardedMemoryManager() {
+	shutdown();
+	for (size_t ii = 0; ii < shards.size(); ii += 1) {
+		delete shards[ii];
+	}
+}
+
+//Every shard needs at least 1 word, so a heap smaller than the number of shards only uses as many shards as it has words
+void ShardedMemoryManager::initialize(size_t sizeInWords) {
+	if (sizeInWords >= UINT32_MAX) {
+		return;
+	}
+	shutdown();
+	size_t used = sizeInWords < shards.size() ? sizeInWords : shards.size();
+	size_t base = 0;
+	for (size_t ii = 0; ii < shards.size(); ii += 1) {
+		Shard* shard = shards[ii];
+		std::lock_guard<std::mutex> lock(shard->lock);
+		shard->base = base;
+		shard->words = ii < used ? (sizeInWords / used) + (ii < sizeInWords % used ? 1 : 0) : 0;
+		if (shard->words != 0) {
+			shard->manager.initialize(shard->words);
+			shard->arena = static_cast<uint8_t*>(shard->manager.getArena());
+		}
+		base += shard->words;
+	}
+	capacity = sizeInWords * wordSize;
+}
+
+void ShardedMemoryManager::shutdown() {
+	for (size_t ii = 0; ii < shards.size(); ii += 1) {
+		std::lock_guard<std::mutex> lock(shards[ii]->lock);
+		shards[ii]->manager.shutdown();
+		shards[ii]->words = 0;
+		shards[ii]->arena = nullptr;
+	}
+	capacity = 0;
+}
+
+//Tries the calling thread's shard first, then every other shard in order
+void* ShardedMemoryManager::allocate(size_t sizeInBytes) {
+	unsigned int home = HomeShard();
+	for (size_t ii = 0; ii < shards.size(); ii += 1) {
+		Shard* shard = shards[(home + ii) % shards.size()];
+		if (shard->words == 0) {
+			continue;
+		}
+		std::lock_guard<std::mutex> lock(shard->lock);
+		void* block = shard->manager.allocate(sizeInBytes);
+		if (block != nullptr) {
+			return block;
+		}
+	}
+	return nullptr;
+}
+
+//Addresses outside every shard's arena are ignored
+void ShardedMemoryManager::free(void* address) {
+	uint8_t* byte = static_cast<uint8_t*>(address);
+	for (size_t ii = 0; ii < shards.size(); ii += 1) {
+		Shard* shard = shards[ii];
+		if (shard->arena != nullptr && byte >= shard->arena && byte < shard->arena + (shard->words * sizeof(uint64_t))) {
+			std::lock_guard<std::mutex> lock(shard->lock);
+			shard->manager.free(address);
+			return;
+		}
+	}
+}
+
+//The merged 16-bit hole list, only exact while every merged offset and size fits in 16 bits. Use getList32() for larger heaps
+void* ShardedMemoryManager::getList() {
+	std::vector<std::pair<unsigned int, unsigned int>> v;
+	FindFreeBlocks(v);
+	if (v.size() == 0) {
+		return nullptr;
+	}
+	uint16_t* list = new uint16_t[(v.size() * 2) + 1];
+	list[0] = v.size();
+	for (size_t ii = 0; ii < v.size(); ii += 1) {
+		list[(ii * 2) + 1] = v[ii].first;
+		list[(ii * 2) + 2] = v[ii].second;
+	}
+	return list;
+}
+
+void* ShardedMemoryManager::getList32() {
+	std::vector<std::pair<unsigned int, unsigned int>> v;
+	FindFreeBlocks(v);
+	if (v.size() == 0) {
+		return nullptr;
+	}
+	uint32_t* list = new uint32_t[(v.size() * 2) + 1];
+	list[0] = v.size();
+	for (size_t ii = 0; ii < v.size(); ii += 1) {
+		list[(ii * 2) + 1] = v[ii].first;
+		list[(ii * 2) + 2] = v[ii].second;
+	}
+	return list;
+}
+
+//The same format as MemoryManager::getBitmap(), with the size in 2 bytes
+void* ShardedMemoryManager::getBitmap() {
+	return BuildBitmap(2);
+}
+
+//The same bitmap with the size in 4 bytes, as MemoryManager::getBitmap32()
+void* ShardedMemoryManager::getBitmap32() {
+	return BuildBitmap(4);
+}
+
+//Shards never have a backend, so each has the packed bitmap of its block list. These are joined 64 words at a time,
+//each element shifted across two merged elements when the shard does not start on a multiple of 64 words
+uint8_t* ShardedMemoryManager::BuildBitmap(unsigned int headerBytes) {
+	size_t words = capacity / wordSize;
+	std::vector<uint64_t> merged((words + 63) / 64, 0);
+	for (size_t ii = 0; ii < shards.size(); ii += 1) {
+		std::lock_guard<std::mutex> lock(shards[ii]->lock);
+		const std::vector<uint64_t>& bits = *shards[ii]->manager.getPackedBitmap();
+		size_t first = shards[ii]->base / 64;
+		unsigned int shift = shards[ii]->base % 64;
+		size_t elements = (shards[ii]->words + 63) / 64;
+		for (size_t element = 0; element < elements; element += 1) {
+			uint64_t value = bits[element];
+			//The bits past the end of the shard belong to the next shard
+			if (element == elements - 1 && shards[ii]->words % 64 != 0) {
+				value &= (1ull << (shards[ii]->words % 64)) - 1;
+			}
+			merged[first + element] |= value << shift;
+			if (shift != 0 && first + element + 1 < merged.size()) {
+				merged[first + element + 1] |= value >> (64 - shift);
+			}
+		}
+	}
+
+	size_t length = (words + 7) / 8;
+	uint8_t* bitMap = new uint8_t[length + headerBytes];
+	for (unsigned int ii = 0; ii < headerBytes; ii += 1) {
+		bitMap[ii] = (length >> (8 * ii)) & 0xFF;
+	}
+	for (size_t ii = 0; ii < length; ii += 1) {
+		bitMap[headerBytes + ii] = (merged[ii / 8] >> (8 * (ii % 8))) & 0xFF;
+	}
+	return bitMap;
+}
+
+int ShardedMemoryManager::dumpMemoryMap(char* filename) {
+	std::vector<std::pair<unsigned int, unsigned int>> v;
+	FindFreeBlocks(v);
+	unsigned int bufferSize = 0;
+	char* buffer = MemoryManager::formatHoles(v, bufferSize);
+	int status = MemoryManager::writeMemoryMap(filename, buffer, bufferSize);
+	delete[] buffer;
+	return status;
+}
+
+MemoryManager::Stats ShardedMemoryManager::getStats() {
+	MemoryManager::Stats stats = { 0, 0, 0, 0 };
+	for (size_t ii = 0; ii < shards.size(); ii += 1) {
+		std::lock_guard<std::mutex> lock(shards[ii]->lock);
+		MemoryManager::Stats shardStats = shards[ii]->manager.getStats();
+		stats.freeWords += shardStats.freeWords;
+		stats.holes += shardStats.holes;
+		stats.largestHole = shardStats.largestHole > stats.largestHole ? shardStats.largestHole : stats.largestHole;
+	}
+	stats.externalFragmentation = stats.freeWords == 0 ? 0 : 1.0 - ((double)stats.largestHole / stats.freeWords);
+	return stats;
+}
+
+unsigned ShardedMemoryManager::getWordSize() {
+	return wordSize;
+}
+
+size_t ShardedMemoryManager::getMemoryLimit() {
+	return capacity;
+}
+
+unsigned int ShardedMemoryManager::getShardCount() {
+	return shards.size();
+}
+
+//Threads take a ticket the first time they allocate from any sharded manager, so consecutive threads land on consecutive shards
+//With BY_CPU the shard follows the CPU the thread is running on, falling back to the ticket where the CPU is not known
+unsigned int ShardedMemoryManager::HomeShard() {
+	static std::atomic<unsigned int> nextTicket(0);
+	static thread_local unsigned int ticket = nextTicket.fetch_add(1);
+#ifdef __linux__
+	if (assignment == BY_CPU) {
+		int cpu = sched_getcpu();
+		if (cpu >= 0) {
+			return (unsigned int)cpu % shards.size();
+		}
+	}
+#endif
+	return ticket % shards.size();
+}
+
+//Collects the holes of every shard in address order, moved to where the shard starts in the merged view
+void ShardedMemoryManager::FindFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v) {
+	for (size_t ii = 0; ii < shards.size(); ii += 1) {
+		Shard* shard = shards[ii];
+		std::lock_guard<std::mutex> lock(shard->lock);
+		if (shard->words == 0) {
+			continue;
+		}
+		uint32_t* list = static_cast<uint32_t*>(shard->manager.getList32());
+		if (list == nullptr) {
+			continue;
+		}
+		for (uint32_t jj = 0; jj < list[0]; jj += 1) {
+			v.push_back(std::make_pair((unsigned int)(shard->base + list[(jj * 2) + 1]), list[(jj * 2) + 2]));
+		}
+		delete[] list;
+	}
+}
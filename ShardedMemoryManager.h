@@ -0,0 +1,62 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include "MemoryManager.h"
+
+//Splits the capacity into independent shards, each a MemoryManager with its own arena, block list, hole index and lock
+//Each thread allocates from its own shard, chosen round-robin as threads first allocate or by the CPU the thread is running on,
+//and moves on to the next shards when its shard has no hole that fits. Frees go to the shard whose arena holds the address
+//getList(), getBitmap() and dumpMemoryMap() show one heap where shard ii starts at the word after shard ii - 1 ends. Holes on either side of
+//a shard boundary are in different arenas so they are not merged, and each shard is read under its own lock so the view is not one snapshot
+class ShardedMemoryManager {
+public:
+	enum Assignment { ROUND_ROBIN, BY_CPU };
+
+	//___________Constructors and Destructors______________
+	ShardedMemoryManager(unsigned wordSize, std::function<int(int, void*)> allocator, unsigned int shardCount, Assignment assignment);
+	~ShardedMemoryManager();
+	//The first sizeInWords % shardCount shards get one word more than the others
+	void initialize(size_t sizeInWords);
+	void shutdown();
+
+	//___________Allocating and Freeing_____________
+	void* allocate(size_t sizeInBytes);
+	void free(void* address);
+
+	//____________Merged Representations of the Shards____________
+	void* getList();
+	void* getList32();
+	void* getBitmap();
+	void* getBitmap32();
+	int dumpMemoryMap(char* filename);
+	//Sums the shard counters. The largest hole is the largest in any one shard, since holes in different shards are never merged
+	MemoryManager::Stats getStats();
+
+	//____________Getters_____________
+	unsigned getWordSize();
+	size_t getMemoryLimit();
+	unsigned int getShardCount();
+
+private:
+	//Each shard's words are [base, base + words) of the merged view
+	struct Shard {
+		MemoryManager manager;
+		std::mutex lock;
+		size_t base;
+		size_t words;
+		uint8_t* arena;
+
+		Shard(unsigned wordSize, std::function<int(int, void*)> allocator) : manager(wordSize, allocator), base(0), words(0), arena(nullptr) {}
+	};
+
+	unsigned int HomeShard();
+	uint8_t* BuildBitmap(unsigned int headerBytes);
+	void FindFreeBlocks(std::vector<std::pair<unsigned int, unsigned int>>& v);
+
+	unsigned wordSize;
+	Assignment assignment;
+	std::vector<Shard*> shards;
+	size_t capacity;
+};
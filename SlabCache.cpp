@@ -0,0 +1,152 @@
+#include "SlabCache.h"
+
+//____________________________________________________________________________________________________Slab Cache______________________________________________________________________________________________________
+//Objects are rounded up to whole words of the manager, and to at least a pointer so a free object can hold the free list link
+SlabCache::SlabCache(MemoryManager& manager, size_t objectSize, unsigned int objectsPerSlab) : manager(manager) {
+	if (objectSize < sizeof(void*)) {
+		objectSize = sizeof(void*);
+	}
+	unsigned int wordSize = manager.getWordSize();
+	this->objectSize = ((objectSize + wordSize - 1) / wordSize) * wordSize;
+	this->objectsPerSlab = objectsPerSlab == 0 ? 1 : objectsPerSlab;
+	partial = nullptr;
+}
+
+SlabCache::~SlabCache() {
+	Clear();
+}
+
+//Gives every slab back to the manager, objects still in use are no longer valid
+void SlabCache::Clear() {
+	for (std::unordered_map<uintptr_t, Slab*>::iterator it = slabs.begin(); it != slabs.end(); ++it) {
+		manager.free(it->second->start);
+		delete it->second;
+	}
+	slabs.clear();
+	partial = nullptr;
+}
+
+//Pops the first free object of the first slab with free objects, creating a slab if every slab is full
+void* SlabCache::allocate() {
+	if (partial == nullptr) {
+		if (CreateSlab() == nullptr) {
+			return nullptr;
+		}
+	}
+	Slab* slab = partial;
+	void* object = slab->freeList;
+	slab->freeList = *static_cast<void**>(object);
+	slab->inUse += 1;
+	size_t index = (static_cast<uint8_t*>(object) - slab->start) / objectSize;
+	slab->freeBits[index / 64] &= ~(1ull << (index % 64));
+
+	//A slab with no free objects left is taken off the partial list until one of its objects is freed
+	if (slab->freeList == nullptr) {
+		UnlinkPartial(slab);
+	}
+	return object;
+}
+
+//Pushes the object on the free list of its slab. Objects not from this cache and objects that are already free are ignored
+void SlabCache::free(void* object) {
+	uint8_t* address = static_cast<uint8_t*>(object);
+	Slab* slab = FindSlab(address);
+	if (slab == nullptr) {
+		return;
+	}
+	size_t distance = address - slab->start;
+	if (distance % objectSize != 0) {
+		return;
+	}
+
+	//A second free would count the object twice and could give the slab back while its other objects are in use
+	size_t index = distance / objectSize;
+	if (slab->freeBits[index / 64] & (1ull << (index % 64))) {
+		return;
+	}
+	slab->freeBits[index / 64] |= 1ull << (index % 64);
+
+	if (slab->freeList == nullptr) {
+		LinkPartial(slab);
+	}
+	*static_cast<void**>(object) = slab->freeList;
+	slab->freeList = object;
+	slab->inUse -= 1;
+
+	//An empty slab goes back to the manager
+	if (slab->inUse == 0) {
+		UnlinkPartial(slab);
+		slabs.erase((uintptr_t)slab->start / (objectSize * objectsPerSlab));
+		manager.free(slab->start);
+		delete slab;
+	}
+}
+
+size_t SlabCache::getObjectSize() {
+	return objectSize;
+}
+
+unsigned int SlabCache::getSlabCount() {
+	return slabs.size();
+}
+
+//Allocates a slab from the manager and threads every object of it onto its free list in address order
+SlabCache::Slab* SlabCache::CreateSlab() {
+	uint8_t* start = static_cast<uint8_t*>(manager.allocate(objectSize * objectsPerSlab));
+	if (start == nullptr) {
+		return nullptr;
+	}
+	Slab* slab = new Slab;
+	slab->start = start;
+	slab->freeBits.assign((objectsPerSlab + 63) / 64, ~0ull);
+	slab->inUse = 0;
+	slab->next = nullptr;
+	slab->prev = nullptr;
+	for (unsigned int ii = 0; ii < objectsPerSlab; ii += 1) {
+		void* next = ii + 1 < objectsPerSlab ? start + ((ii + 1) * objectSize) : nullptr;
+		*reinterpret_cast<void**>(start + (ii * objectSize)) = next;
+	}
+	slab->freeList = start;
+	slabs[(uintptr_t)start / (objectSize * objectsPerSlab)] = slab;
+	LinkPartial(slab);
+	return slab;
+}
+
+//Returns the slab holding address, or nullptr if it is not in a slab of this cache
+SlabCache::Slab* SlabCache::FindSlab(uint8_t* address) {
+	size_t slabSize = objectSize * objectsPerSlab;
+	uintptr_t chunk = (uintptr_t)address / slabSize;
+	//The slab starts in the chunk of the address or the one before it
+	for (uintptr_t ii = 0; ii < 2 && ii <= chunk; ii += 1) {
+		std::unordered_map<uintptr_t, Slab*>::iterator it = slabs.find(chunk - ii);
+		if (it != slabs.end() && address >= it->second->start && address < it->second->start + slabSize) {
+			return it->second;
+		}
+	}
+	return nullptr;
+}
+
+//Adds the slab to the front of the partial list
+void SlabCache::LinkPartial(Slab* slab) {
+	slab->prev = nullptr;
+	slab->next = partial;
+	if (partial != nullptr) {
+		partial->prev = slab;
+	}
+	partial = slab;
+}
+
+//Removes the slab from the partial list
+void SlabCache::UnlinkPartial(Slab* slab) {
+	if (slab->prev != nullptr) {
+		slab->prev->next = slab->next;
+	}
+	else {
+		partial = slab->next;
+	}
+	if (slab->next != nullptr) {
+		slab->next->prev = slab->prev;
+	}
+	slab->next = nullptr;
+	slab->prev = nullptr;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+#include "MemoryManager.h"
+
+//A cache of fixed size objects. Slabs of objectsPerSlab objects are allocated from a MemoryManager and each slab keeps its free objects
+//in an intrusive list through the objects themselves, so allocating and freeing an object never goes through the manager's allocator
+//A slab that has no objects in use is given back to the manager. Freeing an object that is already free, or is not from this cache, is ignored
+class SlabCache {
+public:
+	//Each slab keeps a list of its free objects, a bit for each object that is set while it is free, and how many of its objects are in use
+	//Slabs with free objects are linked together so allocate can find one in O(1)
+	struct Slab {
+		uint8_t* start;
+		void* freeList;
+		std::vector<uint64_t> freeBits;
+		unsigned int inUse;
+		Slab* next;
+		Slab* prev;
+	};
+
+	//___________Constructors and Destructors______________
+	SlabCache(MemoryManager& manager, size_t objectSize, unsigned int objectsPerSlab);
+	~SlabCache();
+	void Clear();
+
+	//___________Allocating and Freeing Objects_____________
+	void* allocate();
+	void free(void* object);
+
+	//____________Getters_____________
+	size_t getObjectSize();
+	unsigned int getSlabCount();
+
+private:
+	Slab* CreateSlab();
+	Slab* FindSlab(uint8_t* address);
+	void LinkPartial(Slab* slab);
+	void UnlinkPartial(Slab* slab);
+
+	MemoryManager& manager;
+	size_t objectSize;
+	unsigned int objectsPerSlab;
+	//Slabs with at least one free object
+	Slab* partial;
+	//Every slab by the slab sized chunk of addresses it starts in. A slab covers at most 2 chunks and no other slab starts in its first one,
+	//so the slab an object belongs to starts in the object's chunk or the one before it and free finds it in O(1)
+	std::unordered_map<uintptr_t, Slab*> slabs;
+};
@@ -0,0 +1,86 @@
+#include "TlsfEngine.h"
+#include "BitOps.h"
+
+//______________________________________________________________________________TLSF Engine_______________________________________________________________________________
+//Empties every free list and both levels of bitmaps
+void TlsfEngine::Reset(unsigned int capacity, uint64_t* arena) {
+	this->arena = arena;
+	flBitmap = 0;
+	for (unsigned int fl = 0; fl < FL_CLASSES; fl += 1) {
+		slBitmap[fl] = 0;
+		for (unsigned int sl = 0; sl < SL_CLASSES; sl += 1) {
+			heads[fl][sl] = NONE;
+		}
+	}
+}
+
+//Pushes the hole on the front of the list for its size class and marks the list as having holes
+//Holes in the classes that cover more than one size also keep their size in their second word
+void TlsfEngine::InsertHole(unsigned int offset, unsigned int size) {
+	unsigned int fl, sl;
+	Mapping(size, fl, sl);
+	unsigned int head = heads[fl][sl];
+	SetLinks(offset, NONE, head);
+	if (size >= SL_CLASSES) {
+		arena[offset + 1] = size;
+	}
+	if (head != NONE) {
+		SetLinks(head, offset, GetNext(head));
+	}
+	heads[fl][sl] = offset;
+	slBitmap[fl] |= (1u << sl);
+	flBitmap |= (1u << fl);
+}
+
+//Unlinks the hole from the list for its size class, clearing the bitmap bits if the list becomes empty
+void TlsfEngine::EraseHole(unsigned int offset, unsigned int size) {
+	unsigned int fl, sl;
+	Mapping(size, fl, sl);
+	unsigned int prev = GetPrev(offset);
+	unsigned int next = GetNext(offset);
+	if (prev != NONE) {
+		SetLinks(prev, GetPrev(prev), next);
+	}
+	else {
+		heads[fl][sl] = next;
+	}
+	if (next != NONE) {
+		SetLinks(next, prev, GetNext(next));
+	}
+	if (heads[fl][sl] == NONE) {
+		slBitmap[fl] &= ~(1u << sl);
+		if (slBitmap[fl] == 0) {
+			flBitmap &= ~(1u << fl);
+		}
+	}
+}
+
+unsigned int TlsfEngine::GetLargestHole() {
+	if (flBitmap == 0) {
+		return 0;
+	}
+	unsigned int fl = HighestSetBit(flBitmap);
+	unsigned int sl = HighestSetBit(slBitmap[fl]);
+	//The classes below SL_CLASSES hold one size each, and it is not stored in the hole
+	if (fl == 0) {
+		return sl;
+	}
+	unsigned int largest = 0;
+	for (unsigned int offset = heads[fl][sl]; offset != NONE; offset = GetNext(offset)) {
+		largest = arena[offset + 1] > largest ? (unsigned int)arena[offset + 1] : largest;
+	}
+	return largest;
+}
+
+//The first word of a hole holds the offset of the previous hole in its list in the high 32 bits and the next hole in the low 32 bits
+unsigned int TlsfEngine::GetNext(unsigned int offset) {
+	return (unsigned int)(arena[offset] & 0xFFFFFFFF);
+}
+
+unsigned int TlsfEngine::GetPrev(unsigned int offset) {
+	return (unsigned int)(arena[offset] >> 32);
+}
+
+void TlsfEngine::SetLinks(unsigned int offset, unsigned int prev, unsigned int next) {
+	arena[offset] = ((uint64_t)prev << 32) | next;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "AllocatorEngine.h"
+#include "BitOps.h"
+
+//Two-Level Segregated Fit: holes are kept in free lists by size class, where the first level splits sizes by powers of 2
+//and the second level splits each power of 2 into SL_CLASSES equal ranges. A bitmap per level records which lists have holes,
+//so finding a hole is a couple of find-first-set operations and inserting or erasing a hole is a few pointer writes, all O(1)
+//The free list links are kept in the first word of each hole in the arena, so the engine needs no memory per hole
+//Only the hole search and hole upkeep are O(1). Through MemoryManager every fill and free also marks the block's words in the memory's
+//occupancy bitmap, which is O(size / 64), and GetLargestHole walks a whole size class
+class TlsfEngine : public AllocatorEngine {
+public:
+	void Reset(unsigned int capacity, uint64_t* arena) override;
+	void InsertHole(unsigned int offset, unsigned int size) override;
+	void EraseHole(unsigned int offset, unsigned int size) override;
+	int64_t FindHole(unsigned int sizeInWords) override;
+	//Walks the one list of the highest non-empty size class, since the holes in a class are not kept in order of size, so it is O(holes in that class)
+	unsigned int GetLargestHole() override;
+
+	static const unsigned int SL_BITS = 4;
+	static const unsigned int SL_CLASSES = 1 << SL_BITS;
+	static const unsigned int FL_CLASSES = 32;
+
+private:
+	void Mapping(uint64_t size, unsigned int& fl, unsigned int& sl);
+	unsigned int GetNext(unsigned int offset);
+	unsigned int GetPrev(unsigned int offset);
+	void SetLinks(unsigned int offset, unsigned int prev, unsigned int next);
+
+	//Offset used to end a free list
+	static const unsigned int NONE = 0xFFFFFFFF;
+
+	uint64_t* arena;
+	uint32_t flBitmap;
+	uint32_t slBitmap[FL_CLASSES];
+	unsigned int heads[FL_CLASSES][SL_CLASSES];
+};
+
+//The search is defined here so a PolicyMemoryManager, which calls it without virtual dispatch, can inline it
+
+//Sizes below SL_CLASSES each get their own list in the first level. Larger sizes go to first level (log2(size) - SL_BITS + 1)
+//and the second level is the next SL_BITS bits of the size after its highest set bit
+inline void TlsfEngine::Mapping(uint64_t size, unsigned int& fl, unsigned int& sl) {
+	if (size < SL_CLASSES) {
+		fl = 0;
+		sl = (unsigned int)size;
+	}
+	else {
+		unsigned int log2 = HighestSetBit(size);
+		fl = log2 - SL_BITS + 1;
+		sl = (unsigned int)(size >> (log2 - SL_BITS)) ^ SL_CLASSES;
+	}
+}
+
+//Rounds the size up to the next size class so every hole in the class found is large enough, then finds the first non-empty class
+//at or above it with one find-first-set on each level
+inline int64_t TlsfEngine::FindHole(unsigned int sizeInWords) {
+	if (sizeInWords == 0) {
+		sizeInWords = 1;
+	}
+	uint64_t rounded = sizeInWords;
+	if (rounded >= SL_CLASSES) {
+		rounded += (1ull << (HighestSetBit(rounded) - SL_BITS)) - 1;
+	}
+	unsigned int fl, sl;
+	Mapping(rounded, fl, sl);
+
+	uint32_t slBits = fl < FL_CLASSES ? slBitmap[fl] & (0xFFFFFFFFu << sl) : 0;
+	if (slBits == 0) {
+		uint32_t flBits = fl + 1 < FL_CLASSES ? flBitmap & (0xFFFFFFFFu << (fl + 1)) : 0;
+		if (flBits != 0) {
+			fl = LowestSetBit(flBits);
+			slBits = slBitmap[fl];
+		}
+	}
+	if (slBits != 0) {
+		return (int64_t)heads[fl][LowestSetBit(slBits)];
+	}
+
+	//Rounding up skips the class the size itself falls in, whose holes may still fit. Checking only the head of that list keeps the search O(1)
+	Mapping(sizeInWords, fl, sl);
+	unsigned int head = heads[fl][sl];
+	if (head != NONE && arena[head + 1] >= sizeInWords) {
+		return (int64_t)head;
+	}
+	return -1;
+}
@@ -0,0 +1,191 @@
+#include "TraceReplay.h"
+#include <chrono>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//Reads little endian values of n bytes from anywhere in the mapping
+static uint64_t ReadLittleEndian(const uint8_t* bytes, unsigned int n) {
+	uint64_t value = 0;
+	for (unsigned int ii = 0; ii < n; ii += 1) {
+		value |= (uint64_t)bytes[ii] << (8 * ii);
+	}
+	return value;
+}
+
+static void WriteLittleEndian(std::vector<uint8_t>& buffer, uint64_t value, unsigned int n) {
+	for (unsigned int ii = 0; ii < n; ii += 1) {
+		buffer.push_back((value >> (8 * ii)) & 0xFF);
+	}
+}
+
+//_____________________________________________________________________________________________________Trace Replay________________________________________________________________________________________________
+const unsigned int TraceReplay::HEADER_SIZE;
+
+TraceReplay::TraceReplay(MemoryManager& manager) : manager(manager), denseIds(0) {
+}
+
+int TraceReplay::replay(const char* filename, ReplayReport& report) {
+	memset(&report, 0, sizeof(report));
+	clear();
+
+	//Map the whole file read only, the kernel reads it ahead as the records are walked in order
+	int fd = open(filename, O_RDONLY);
+	if (fd == -1) {
+		return -1;
+	}
+	struct stat status;
+	if (fstat(fd, &status) == -1 || (size_t)status.st_size < HEADER_SIZE) {
+		close(fd);
+		return -1;
+	}
+	size_t length = status.st_size;
+	void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		return -1;
+	}
+	madvise(mapping, length, MADV_SEQUENTIAL);
+
+	const uint8_t* bytes = static_cast<const uint8_t*>(mapping);
+	if (memcmp(bytes, "MTRC", 4) != 0 || ReadLittleEndian(bytes + 4, 2) != 1) {
+		munmap(mapping, length);
+		return -1;
+	}
+	unsigned int recordSize = (ReadLittleEndian(bytes + 6, 2) & 1) ? 17 : 9;
+	uint64_t records = ReadLittleEndian(bytes + 8, 8);
+	if (records > (length - HEADER_SIZE) / recordSize) {
+		records = (length - HEADER_SIZE) / recordSize;
+	}
+
+	//A trace numbered from 0 has fewer ids than records, so the table is never larger than the trace
+	denseIds = records;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const uint8_t* record = bytes + HEADER_SIZE;
+	for (uint64_t ii = 0; ii < records; ii += 1) {
+		Apply(record[0], (uint32_t)ReadLittleEndian(record + 1, 4), (uint32_t)ReadLittleEndian(record + 5, 4), report);
+		record += recordSize;
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	munmap(mapping, length);
+
+	report.records = records;
+	report.seconds = elapsed.count();
+	report.operationsPerSecond = report.seconds > 0 ? records / report.seconds : 0;
+	Summarize(report);
+	return 0;
+}
+
+void TraceReplay::clear() {
+	for (size_t ii = 0; ii < blocks.size(); ii += 1) {
+		if (blocks[ii] != nullptr) {
+			manager.free(blocks[ii]);
+		}
+	}
+	blocks.clear();
+	for (std::unordered_map<uint32_t, void*>::iterator it = sparseBlocks.begin(); it != sparseBlocks.end(); ++it) {
+		manager.free(it->second);
+	}
+	sparseBlocks.clear();
+}
+
+//Writes the header and records in the format replay() reads
+int TraceReplay::writeTrace(const char* filename, const std::vector<TraceRecord>& records, bool timestamps) {
+	std::vector<uint8_t> buffer;
+	buffer.reserve(HEADER_SIZE + (records.size() * (timestamps ? 17 : 9)));
+	buffer.insert(buffer.end(), { 'M', 'T', 'R', 'C' });
+	WriteLittleEndian(buffer, 1, 2);
+	WriteLittleEndian(buffer, timestamps ? 1 : 0, 2);
+	WriteLittleEndian(buffer, records.size(), 8);
+	for (size_t ii = 0; ii < records.size(); ii += 1) {
+		WriteLittleEndian(buffer, records[ii].op, 1);
+		WriteLittleEndian(buffer, records[ii].id, 4);
+		WriteLittleEndian(buffer, records[ii].size, 4);
+		if (timestamps) {
+			WriteLittleEndian(buffer, records[ii].timestamp, 8);
+		}
+	}
+
+	int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+	if (fd == -1) {
+		return -1;
+	}
+	//write may take less than the whole buffer, so keep writing from where it stopped
+	size_t written = 0;
+	while (written < buffer.size()) {
+		ssize_t ret = write(fd, buffer.data() + written, buffer.size() - written);
+		if (ret == -1) {
+			close(fd);
+			return -1;
+		}
+		written += ret;
+	}
+	return close(fd);
+}
+
+//Allocates or frees the block of one record
+void TraceReplay::Apply(uint8_t op, uint32_t id, uint32_t size, ReplayReport& report) {
+	if (op == ALLOCATE) {
+		report.allocations += 1;
+		report.sparseIds += id >= denseIds ? 1 : 0;
+		//An id allocated again before it was freed keeps its first block, the new one is freed so it does not leak
+		void* block = manager.allocate(size);
+		if (block == nullptr) {
+			report.failedAllocations += 1;
+			return;
+		}
+		void** slot = FindBlock(id, true);
+		if (*slot != nullptr) {
+			manager.free(block);
+		}
+		else {
+			*slot = block;
+		}
+	}
+	else if (op == FREE) {
+		report.frees += 1;
+		void** slot = FindBlock(id, false);
+		if (slot == nullptr || *slot == nullptr) {
+			report.unknownFrees += 1;
+			return;
+		}
+		manager.free(*slot);
+		if (id < denseIds) {
+			*slot = nullptr;
+		}
+		else {
+			sparseBlocks.erase(id);
+		}
+	}
+}
+
+//Returns the entry for id in the table or the hash table, or nullptr if it has none and create is false
+void** TraceReplay::FindBlock(uint32_t id, bool create) {
+	if (id < denseIds) {
+		if (id >= blocks.size()) {
+			if (!create) {
+				return nullptr;
+			}
+			blocks.resize((size_t)id + 1, nullptr);
+		}
+		return &blocks[id];
+	}
+	std::unordered_map<uint32_t, void*>::iterator it = sparseBlocks.find(id);
+	if (it != sparseBlocks.end()) {
+		return &it->second;
+	}
+	if (!create) {
+		return nullptr;
+	}
+	return &sparseBlocks[id];
+}
+
+//Fills in the fragmentation of the heap the replay left
+void TraceReplay::Summarize(ReplayReport& report) {
+	MemoryManager::Stats stats = manager.getStats();
+	report.holes = stats.holes;
+	report.freeWords = stats.freeWords;
+	report.largestHole = stats.largestHole;
+	report.externalFragmentation = stats.externalFragmentation;
+	report.internalFragmentation = manager.getInternalFragmentation();
+}
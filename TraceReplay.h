@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include "MemoryManager.h"
+
+//Replays a binary trace of allocations and frees against a MemoryManager. The file is memory mapped and read in one pass, so there is no
+//system call per record and a trace of hundreds of millions of records is never copied into memory
+//
+//The file starts with a 16 byte header, and every value is little endian:
+//	"MTRC", uint16 version (1), uint16 flags (Bit 0 set if records have timestamps), uint64 number of records
+//Each record is 9 bytes, or 17 with timestamps:
+//	uint8 op (0 allocate, 1 free), uint32 id, uint32 size in bytes (Ignored by frees), uint64 timestamp
+//An allocation's id names the block until it is freed. Ids below the number of records index a table, and any larger id, such as one from
+//a sparse or corrupt trace, is kept in a hash table instead so it never sizes the table
+class TraceReplay {
+public:
+	enum Operation { ALLOCATE = 0, FREE = 1 };
+
+	struct TraceRecord {
+		uint8_t op;
+		uint32_t id;
+		uint32_t size;
+		uint64_t timestamp;
+	};
+
+	struct ReplayReport {
+		uint64_t records;
+		uint64_t allocations;
+		//Allocations the manager returned nullptr for
+		uint64_t failedAllocations;
+		uint64_t frees;
+		//Frees of ids that were never allocated, already freed, or whose allocation failed
+		uint64_t unknownFrees;
+		//Allocations whose id was not below the number of records, so it went in the hash table
+		uint64_t sparseIds;
+		double seconds;
+		double operationsPerSecond;
+		//Holes left at the end of the replay, and 1 - (largest hole / free words), which is 0 when all the free words are in one hole
+		uint64_t holes;
+		uint64_t freeWords;
+		uint64_t largestHole;
+		double externalFragmentation;
+		unsigned long long internalFragmentation;
+	};
+
+	//___________Constructors______________
+	TraceReplay(MemoryManager& manager);
+
+	//___________Replaying Traces_____________
+	//Returns 0 if the trace was replayed and -1 if the file could not be opened, mapped or is not a trace. A file cut short replays its whole records
+	int replay(const char* filename, ReplayReport& report);
+	//Blocks still allocated when the replay ended are freed by clear(), or by the next replay
+	void clear();
+
+	//___________Writing Traces_____________
+	static int writeTrace(const char* filename, const std::vector<TraceRecord>& records, bool timestamps);
+
+private:
+	static const unsigned int HEADER_SIZE = 16;
+
+	void Apply(uint8_t op, uint32_t id, uint32_t size, ReplayReport& report);
+	void** FindBlock(uint32_t id, bool create);
+	void Summarize(ReplayReport& report);
+
+	MemoryManager& manager;
+	//blocks[id] is the block the allocation with that id returned, or nullptr, for ids below denseIds. Other ids are in sparseBlocks
+	std::vector<void*> blocks;
+	std::unordered_map<uint32_t, void*> sparseBlocks;
+	uint64_t denseIds;
+};
@@ -0,0 +1,225 @@
+//Runs seeded workloads against every allocator and engine and prints one JSON object per line with the latency percentiles, throughput and peak fragmentation
+//Usage: allocator_bench [operations] [seed]
+//Built with make INSTRUMENT=1 each line also has the cycles spent building hole lists, scanning them and finding blocks
+//Each workload is a size distribution (uniform, power-law, bimodal) and a lifetime order (LIFO, FIFO, random). The same seed gives the same
+//sequence of allocations and frees for every allocator, so runs of two versions can be compared line by line
+#include "../MemoryManager.h"
+#include "../PolicyMemoryManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+//Every workload fits in a heap the 16-bit allocators can address directly
+static const size_t HEAP_WORDS = 65535;
+static const size_t LIVE_BLOCKS = 512;
+//Fragmentation is sampled every this many operations, outside of the timed calls
+static const unsigned int SAMPLE_EVERY = 256;
+
+enum SizeDistribution { UNIFORM, POWER_LAW, BIMODAL };
+enum Lifetime { LIFO, FIFO, RANDOM };
+
+//Allocations carry a size in words, frees the index of the allocation they free
+struct Operation {
+	bool allocate;
+	uint32_t value;
+};
+
+//Draws a size in words from the distribution
+static uint32_t DrawSize(SizeDistribution sizes, std::mt19937_64& random) {
+	std::uniform_real_distribution<double> unit(0.0, 1.0);
+	if (sizes == UNIFORM) {
+		return 1 + (uint32_t)(random() % 64);
+	}
+	if (sizes == POWER_LAW) {
+		//Pareto with shape 1.2, most blocks are a few words and a few are hundreds
+		double size = std::pow(1.0 - unit(random), -1.0 / 1.2);
+		return (uint32_t)std::min(size, 1024.0);
+	}
+	//90% small blocks and 10% large ones
+	if (unit(random) < 0.9) {
+		return 1 + (uint32_t)(random() % 8);
+	}
+	return 128 + (uint32_t)(random() % 129);
+}
+
+//Fills the heap to LIVE_BLOCKS blocks, keeps it there by freeing one block for each allocation, then frees everything
+static std::vector<Operation> MakeWorkload(SizeDistribution sizes, Lifetime lifetime, size_t operations, uint64_t seed) {
+	std::mt19937_64 random(seed);
+	std::vector<Operation> workload;
+	std::deque<uint32_t> live;
+	uint32_t allocations = 0;
+	while (workload.size() + live.size() < operations) {
+		if (live.size() < LIVE_BLOCKS || workload.size() % 2 == 0) {
+			workload.push_back(Operation{ true, DrawSize(sizes, random) });
+			live.push_back(allocations++);
+		}
+		else {
+			uint32_t freed;
+			if (lifetime == LIFO) {
+				freed = live.back();
+				live.pop_back();
+			}
+			else if (lifetime == FIFO) {
+				freed = live.front();
+				live.pop_front();
+			}
+			else {
+				size_t index = random() % live.size();
+				freed = live[index];
+				live[index] = live.back();
+				live.pop_back();
+			}
+			workload.push_back(Operation{ false, freed });
+		}
+	}
+	while (!live.empty()) {
+		workload.push_back(Operation{ false, live.front() });
+		live.pop_front();
+	}
+	return workload;
+}
+
+
+static uint64_t Percentile(std::vector<uint32_t>& sorted, double fraction) {
+	if (sorted.empty()) {
+		return 0;
+	}
+	return sorted[std::min(sorted.size() - 1, (size_t)(fraction * sorted.size()))];
+}
+
+//Replays the workload against an initialized manager and prints its line
+template <class Manager>
+static void Run(const std::string& name, Manager& manager, const std::vector<Operation>& workload, const char* sizes, const char* lifetime) {
+	std::vector<uint64_t*> blocks;
+	std::vector<uint32_t> allocateNanoseconds;
+	std::vector<uint32_t> freeNanoseconds;
+	uint64_t failed = 0;
+	double peakFragmentation = 0;
+
+	Instrumentation::reset();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::duration sampling(0);
+	for (size_t ii = 0; ii < workload.size(); ii += 1) {
+		std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+		if (workload[ii].allocate) {
+			uint64_t* block = static_cast<uint64_t*>(manager.allocate((size_t)workload[ii].value * manager.getWordSize()));
+			std::chrono::steady_clock::time_point after = std::chrono::steady_clock::now();
+			allocateNanoseconds.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count());
+			blocks.push_back(block);
+			failed += block == nullptr ? 1 : 0;
+		}
+		else {
+			manager.free(blocks[workload[ii].value]);
+			std::chrono::steady_clock::time_point after = std::chrono::steady_clock::now();
+			freeNanoseconds.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count());
+		}
+		if (ii % SAMPLE_EVERY == 0) {
+			std::chrono::steady_clock::time_point sampleStart = std::chrono::steady_clock::now();
+			peakFragmentation = std::max(peakFragmentation, manager.getStats().externalFragmentation);
+			sampling += std::chrono::steady_clock::now() - sampleStart;
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start - sampling).count();
+
+	std::sort(allocateNanoseconds.begin(), allocateNanoseconds.end());
+	std::sort(freeNanoseconds.begin(), freeNanoseconds.end());
+	std::cout << "{\"allocator\":\"" << name << "\",\"sizes\":\"" << sizes << "\",\"lifetime\":\"" << lifetime << "\""
+		<< ",\"operations\":" << workload.size() << ",\"failed_allocations\":" << failed
+		<< ",\"allocate_ns_p50\":" << Percentile(allocateNanoseconds, 0.5) << ",\"allocate_ns_p90\":" << Percentile(allocateNanoseconds, 0.9)
+		<< ",\"allocate_ns_p99\":" << Percentile(allocateNanoseconds, 0.99) << ",\"allocate_ns_p999\":" << Percentile(allocateNanoseconds, 0.999)
+		<< ",\"free_ns_p50\":" << Percentile(freeNanoseconds, 0.5) << ",\"free_ns_p90\":" << Percentile(freeNanoseconds, 0.9)
+		<< ",\"free_ns_p99\":" << Percentile(freeNanoseconds, 0.99) << ",\"free_ns_p999\":" << Percentile(freeNanoseconds, 0.999)
+		<< ",\"operations_per_second\":" << (seconds > 0 ? workload.size() / seconds : 0)
+		<< ",\"peak_external_fragmentation\":" << peakFragmentation;
+#ifdef MEMORY_INSTRUMENTATION
+	//Built with make INSTRUMENT=1, the phases of each call are broken out in cycles
+	Instrumentation::Snapshot snapshot = Instrumentation::snapshot();
+	const char* timerNames[] = { "allocate", "free", "hole_list_build", "allocator_scan", "find_block" };
+	for (int timer = Instrumentation::ALLOCATE; timer < Instrumentation::TIMERS; timer += 1) {
+		std::cout << ",\"" << timerNames[timer] << "_calls\":" << snapshot.calls[timer]
+			<< ",\"" << timerNames[timer] << "_cycles\":" << snapshot.cycles[timer]
+			<< ",\"" << timerNames[timer] << "_cycles_p99\":" << Instrumentation::percentile(snapshot, (Instrumentation::Timer)timer, 0.99);
+	}
+	std::cout << ",\"list_nodes_visited\":" << snapshot.counters[Instrumentation::LIST_NODES_VISITED]
+		<< ",\"holes_scanned\":" << snapshot.counters[Instrumentation::HOLES_SCANNED]
+		<< ",\"coalesces\":" << snapshot.counters[Instrumentation::COALESCES];
+#endif
+	std::cout << "}" << std::endl;
+}
+
+template <class Manager>
+static void RunManager(const std::string& name, Manager& manager, const std::vector<Operation>& workload, const char* sizes, const char* lifetime) {
+	manager.initialize(HEAP_WORDS);
+	Run(name, manager, workload, sizes, lifetime);
+	manager.shutdown();
+}
+
+int main(int argc, char** argv) {
+	size_t operations = argc > 1 ? (size_t)atol(argv[1]) : 200000;
+	uint64_t seed = argc > 2 ? (uint64_t)atoll(argv[2]) : 12345;
+	const char* sizeNames[] = { "uniform", "power-law", "bimodal" };
+	const char* lifetimeNames[] = { "lifo", "fifo", "random" };
+
+	for (int sizes = UNIFORM; sizes <= BIMODAL; sizes += 1) {
+		for (int lifetime = LIFO; lifetime <= RANDOM; lifetime += 1) {
+			std::vector<Operation> workload = MakeWorkload((SizeDistribution)sizes, (Lifetime)lifetime, operations, seed);
+			const char* sizeName = sizeNames[sizes];
+			const char* lifetimeName = lifetimeNames[lifetime];
+
+			//Hole list allocators
+			MemoryManager bestFitManager(8, bestFit);
+			RunManager("bestFit", bestFitManager, workload, sizeName, lifetimeName);
+			MemoryManager worstFitManager(8, worstFit);
+			RunManager("worstFit", worstFitManager, workload, sizeName, lifetimeName);
+			MemoryManager firstFitManager(8, firstFit);
+			RunManager("firstFit", firstFitManager, workload, sizeName, lifetimeName);
+
+			//Hole view kernels
+			MemoryManager bestFitViewManager(8, bestFit);
+			bestFitViewManager.setHoleViewAllocator(bestFitView);
+			RunManager("bestFitView", bestFitViewManager, workload, sizeName, lifetimeName);
+			MemoryManager worstFitViewManager(8, worstFit);
+			worstFitViewManager.setHoleViewAllocator(worstFitView);
+			RunManager("worstFitView", worstFitViewManager, workload, sizeName, lifetimeName);
+			MemoryManager firstFitViewManager(8, firstFit);
+			firstFitViewManager.setHoleViewAllocator(firstFitView);
+			RunManager("firstFitView", firstFitViewManager, workload, sizeName, lifetimeName);
+
+			//Engines
+			BestFitEngine bestFitEngine;
+			MemoryManager bestFitEngineManager(8, &bestFitEngine);
+			RunManager("BestFitEngine", bestFitEngineManager, workload, sizeName, lifetimeName);
+			WorstFitEngine worstFitEngine;
+			MemoryManager worstFitEngineManager(8, &worstFitEngine);
+			RunManager("WorstFitEngine", worstFitEngineManager, workload, sizeName, lifetimeName);
+			FirstFitEngine firstFitEngine;
+			MemoryManager firstFitEngineManager(8, &firstFitEngine);
+			RunManager("FirstFitEngine", firstFitEngineManager, workload, sizeName, lifetimeName);
+			NextFitEngine nextFitEngine;
+			MemoryManager nextFitEngineManager(8, &nextFitEngine);
+			RunManager("NextFitEngine", nextFitEngineManager, workload, sizeName, lifetimeName);
+			TlsfEngine tlsfEngine;
+			MemoryManager tlsfEngineManager(8, &tlsfEngine);
+			RunManager("TlsfEngine", tlsfEngineManager, workload, sizeName, lifetimeName);
+			PolicyMemoryManager<BestFitEngine> bestFitPolicyManager(8);
+			RunManager("PolicyMemoryManager<BestFitEngine>", bestFitPolicyManager, workload, sizeName, lifetimeName);
+
+			//Backends
+			BuddyMemory buddyMemory;
+			MemoryManager buddyManager(8, bestFit);
+			buddyManager.setBackend(&buddyMemory);
+			RunManager("BuddyMemory", buddyManager, workload, sizeName, lifetimeName);
+			BitmapMemory bitmapMemory;
+			MemoryManager bitmapManager(8, bestFit);
+			bitmapManager.setBackend(&bitmapMemory);
+			RunManager("BitmapMemory", bitmapManager, workload, sizeName, lifetimeName);
+		}
+	}
+	return 0;
+}
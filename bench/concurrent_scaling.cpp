@@ -0,0 +1,92 @@
+//Measures how allocation throughput scales from 1 to N threads, with every operation behind one lock and with the ConcurrentMemoryManager thread caches
+//Usage: concurrent_scaling [maxThreads] [operationsPerThread]
+//Built by make bench
+#include "../ConcurrentMemoryManager.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Each thread keeps up to 64 blocks of 1 to 32 words live, allocating or freeing one at random
+template <class Allocate, class Free>
+void runThread(unsigned int seed, unsigned int operations, Allocate allocate, Free free) {
+	std::vector<std::pair<void*, size_t>> live;
+	for (unsigned int ii = 0; ii < operations; ii += 1) {
+		seed = seed * 1103515245 + 12345;
+		uint32_t random = seed >> 8;
+		if ((random % 2 == 0 && live.size() < 64) || live.empty()) {
+			size_t bytes = sizeof(uint64_t) * (1 + (random >> 4) % 32);
+			void* block = allocate(bytes);
+			if (block != nullptr) {
+				live.push_back(std::make_pair(block, bytes));
+			}
+		}
+		else {
+			size_t index = (random >> 4) % live.size();
+			free(live[index].first, live[index].second);
+			live[index] = live.back();
+			live.pop_back();
+		}
+	}
+	for (size_t ii = 0; ii < live.size(); ii += 1) {
+		free(live[ii].first, live[ii].second);
+	}
+}
+
+//Runs threads copies of body and returns the operations per second
+template <class Body>
+double measure(unsigned int threads, unsigned int operations, Body body) {
+	std::vector<std::thread> workers;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int t = 0; t < threads; t += 1) {
+		workers.push_back(std::thread(body, 12345 + t));
+	}
+	for (size_t t = 0; t < workers.size(); t += 1) {
+		workers[t].join();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return (double)threads * operations / elapsed.count();
+}
+
+int main(int argc, char** argv) {
+	unsigned int maxThreads = argc > 1 ? (unsigned int)atoi(argv[1]) : std::thread::hardware_concurrency();
+	unsigned int operations = argc > 2 ? (unsigned int)atoi(argv[2]) : 200000;
+	if (maxThreads == 0) {
+		maxThreads = 1;
+	}
+
+	std::cout << "threads,global lock ops/s,thread caches ops/s" << std::endl;
+	//Doubles the threads each run, ending with maxThreads
+	for (unsigned int threads = 1; threads <= maxThreads; threads = (threads < maxThreads && threads * 2 > maxThreads) ? maxThreads : threads * 2) {
+		//Each thread holds at most 64 blocks of at most 32 words
+		size_t words = (size_t)threads * 64 * 32 * 2;
+
+		MemoryManager lockedManager(8, bestFit);
+		lockedManager.initialize(words);
+		std::mutex lock;
+		double locked = measure(threads, operations, [&](unsigned int seed) {
+			runThread(seed, operations,
+				[&](size_t bytes) { std::lock_guard<std::mutex> guard(lock); return lockedManager.allocate(bytes); },
+				[&](void* block, size_t bytes) { std::lock_guard<std::mutex> guard(lock); lockedManager.free(block); });
+		});
+		lockedManager.shutdown();
+
+		MemoryManager centralManager(8, bestFit);
+		centralManager.initialize(words);
+		double cached;
+		{
+			ConcurrentMemoryManager concurrentManager(centralManager, 32);
+			cached = measure(threads, operations, [&](unsigned int seed) {
+				runThread(seed, operations,
+					[&](size_t bytes) { return concurrentManager.allocate(bytes); },
+					[&](void* block, size_t bytes) { concurrentManager.free(block, bytes); });
+			});
+		}
+		centralManager.shutdown();
+
+		std::cout << threads << "," << locked << "," << cached << std::endl;
+	}
+	return 0;
+}
@@ -1,4 +1,10 @@
 #include "MemoryManager.h"
+#include "SlabCache.h"
+#include "PolicyMemoryManager.h"
+#include "ConcurrentMemoryManager.h"
+#include "ShardedMemoryManager.h"
+#include "LockFreePool.h"
+#include "TraceReplay.h"
 #include <string>
 #include <cmath>
 #include <array>
@@ -6,6 +12,8 @@
 #include <fstream>
 #include <vector>
 #include <iostream>
+#include <thread>
+#include <set>
 
 
 /*Test Cases Provided By The Computer Science Department at the University of Florida*/
@@ -21,6 +29,30 @@ unsigned int testRepeatedShutdown();
 unsigned int testMaxInitialization();
 unsigned int testGetters();
 unsigned int testReadingUsingGetMemoryStart();
+unsigned int testInvalidFree();
+unsigned int testInvalidAllocatorOffset();
+unsigned int testBestFitFullHeap();
+unsigned int testNextFit();
+unsigned int testTlsf();
+unsigned int testBuddy();
+unsigned int testSlabCache();
+unsigned int testBitmapBackend();
+unsigned int testLargeHeap();
+unsigned int testAdapterManyHoles();
+unsigned int testGetList32(MemoryManager& memoryManager, std::vector<uint32_t> correctList);
+unsigned int testEngineMatchesAllocator(std::function<int(int, void*)> allocator, AllocatorEngine* engine, std::string name);
+unsigned int testHoleViewMatchesAllocator(std::function<int(int, void*)> allocator, std::function<int64_t(uint64_t, const HoleView&)> holeViewAllocator, std::string name);
+unsigned int testPolicyManager();
+unsigned int testConcurrentManager();
+unsigned int testShardedManager();
+unsigned int testShardedBitmap32();
+unsigned int testLockFreePool();
+unsigned int testTraceReplay();
+unsigned int testTraceReplaySparseIds();
+unsigned int testStats();
+unsigned int testInstrumentation();
+unsigned int testReallocate();
+unsigned int testZeroSizeAllocate();
 
 
 // helper functions
@@ -30,6 +62,10 @@ unsigned int testGetList(MemoryManager& memoryManager, uint16_t correctListLengt
 unsigned int testGetWordSize(MemoryManager& memoryManager, size_t correctWordSize);
 unsigned int testGetMemoryLimit(MemoryManager& memoryManager, size_t correctMemoryLimit);
 unsigned int testDumpMemoryMap(MemoryManager& memoryManager, std::string fileName, std::string correctFileContents);
+bool sameHoleList(MemoryManager& lhs, MemoryManager& rhs);
+unsigned int testStatsWorkload(MemoryManager& memoryManager);
+template <class Manager>
+unsigned int testSameHoles(MemoryManager& lhs, Manager& rhs);
 
 int hopesAndDreamsAllocator(int sizeInWords, void* list)
 {
@@ -79,7 +115,7 @@ int hopesAndDreamsAllocator(int sizeInWords, void* list)
 
 int main()
 {
-    unsigned int maxScore = 38;
+    unsigned int maxScore = 89;
     unsigned int score = 0;
 
     score += testMemoryLeaksNoShutdown(); // 0
@@ -111,6 +147,90 @@ int main()
   score += 5 * testReadingUsingGetMemoryStart(); // 1 * 5
     
   std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testInvalidFree(); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testInvalidAllocatorOffset(); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testBestFitFullHeap(); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    BestFitEngine bestFitEngine;
+    score += testEngineMatchesAllocator(bestFit, &bestFitEngine, "best fit"); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    WorstFitEngine worstFitEngine;
+    score += testEngineMatchesAllocator(worstFit, &worstFitEngine, "worst fit"); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    FirstFitEngine firstFitEngine;
+    score += testEngineMatchesAllocator(firstFit, &firstFitEngine, "first fit"); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testHoleViewMatchesAllocator(bestFit, bestFitView, "best fit"); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testHoleViewMatchesAllocator(worstFit, worstFitView, "worst fit"); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testHoleViewMatchesAllocator(firstFit, firstFitView, "first fit"); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testPolicyManager(); // 3
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testConcurrentManager(); // 2
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testShardedManager(); // 2
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testShardedBitmap32(); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testLockFreePool(); // 2
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testTraceReplay(); // 2
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testTraceReplaySparseIds(); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testStats(); // 2
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testInstrumentation(); // 1
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testReallocate(); // 3
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testZeroSizeAllocate(); // 2
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testNextFit(); // 2
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testTlsf(); // 3
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testBuddy(); // 4
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testBitmapBackend(); // 3
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testSlabCache(); // 4
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testLargeHeap(); // 3
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
+
+    score += testAdapterManyHoles(); // 2
+    std::cout << "Score: " << score << " / " << maxScore << std::endl;
     
 }
 
@@ -612,138 +732,1246 @@ unsigned int testReadingUsingGetMemoryStart()
 }
 
 
-std::string vectorToString(const std::vector<uint16_t>& vector)
+unsigned int testInvalidFree()
 {
-    std::string vectorString = "";
+    std::cout << "Test Case: invalid free, double frees and pointers that do not start a block" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 20;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
 
-    vectorString += "[" + std::to_string(vector[0]) + ", " + std::to_string(vector[1]);
-    for (int i = 2; i < vector.size(); i += 2)
-    {
-        vectorString += "] - [" + std::to_string(vector[i]) + ", " + std::to_string(vector[i + 1]);
-    }
-    vectorString += "]";
+    uint64_t* testArray1 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 5));
+    uint64_t* testArray2 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 5));
+    uint64_t notManaged = 0;
 
-    return vectorString;
+    memoryManager.free(testArray1);
+    memoryManager.free(testArray1);
+    memoryManager.free(testArray2 + 1);
+    memoryManager.free(&notManaged);
+
+    std::vector<uint16_t> correctList = { 0, 5, 10, 10 };
+    uint16_t correctListLength = correctList.size() * 2;
+
+    unsigned int score = testGetList(memoryManager, correctListLength, correctList);
+
+    memoryManager.shutdown();
+
+    return score;
 }
 
 
-unsigned int testGetBitmap(MemoryManager& memoryManager, uint16_t correctBitmapLength, std::vector<uint8_t> correctBitmap)
+unsigned int testInvalidAllocatorOffset()
 {
-    unsigned int score = 0;
-    uint8_t* bitmap = static_cast<uint8_t*>(memoryManager.getBitmap());
-    uint8_t* bitmapEntryPoint = bitmap;
+    std::cout << "Test Case: allocator returns an offset that does not start a hole" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 20;
+    MemoryManager memoryManager(wordSize, [](int sizeInWords, void* list) { return 3; });
+    memoryManager.initialize(numberOfWords);
 
-    uint8_t lowerByte = *bitmap++;
-    uint8_t higherByte = *bitmap++;
-    uint16_t byteStreamLength = (higherByte << 8) | lowerByte;
+    void* testArray1 = memoryManager.allocate(sizeof(uint64_t) * 5);
 
-    std::cout << "Testing getBitmap" << std::endl;
-    std::cout << "Expected: " << std::endl;
-    std::cout << "[0x" << std::hex << (int)correctBitmap[0];
+    std::vector<uint16_t> correctList = { 0, 20 };
+    uint16_t correctListLength = correctList.size() * 2;
 
-    for (uint16_t i = 1; i < correctBitmap.size(); ++i) {
-        std::cout << ", 0x" << std::hex << (int)correctBitmap[i];
+    unsigned int score = 0;
+    if (testArray1 == nullptr) {
+        score = testGetList(memoryManager, correctListLength, correctList);
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
     }
-    std::cout << "]" << std::endl;
 
+    memoryManager.shutdown();
 
-    std::cout << "\n";
-    std::cout << "Got:" << std::endl;
-    std::cout << "[0x" << std::hex << (int)bitmap[0];
-    for (uint16_t i = 1; i < byteStreamLength; ++i) {
-        std::cout << ", 0x" << std::hex << (int)bitmap[i];
+    return score;
+}
+
+
+unsigned int testBestFitFullHeap()
+{
+    std::cout << "Test Case: Best Fit into a single hole of 65535 words" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 65535;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
+
+    void* testArray1 = memoryManager.allocate(sizeof(uint64_t) * 10);
+
+    std::vector<uint16_t> correctList = { 10, 65525 };
+    uint16_t correctListLength = correctList.size() * 2;
+
+    unsigned int score = 0;
+    if (testArray1 != nullptr) {
+        score = testGetList(memoryManager, correctListLength, correctList);
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
     }
-    std::cout << "]" << std::endl;
 
-    for (uint16_t i = 0; i < byteStreamLength; ++i) {
-        if (bitmap[i] != correctBitmap[i]) {
-            delete[] bitmapEntryPoint;
-            std::cout << "[INCORRECT]\n" << std::endl;
-            return score;
-        }
+    // BestFitEngine always found this hole, so it has to leave the same hole list as bestFit
+    BestFitEngine bestFitEngine;
+    MemoryManager engineManager(wordSize, &bestFitEngine);
+    engineManager.initialize(numberOfWords);
+    engineManager.allocate(sizeof(uint64_t) * 10);
+    if (score == 1 && !sameHoleList(memoryManager, engineManager)) {
+        std::cout << "[INCORRECT] BestFitEngine does not match bestFit\n" << std::endl;
+        score = 0;
     }
 
-    ++score;
-    delete[] bitmapEntryPoint;
-    std::cout << "[CORRECT]\n" << std::endl;
+    // bestFit on its own, the 65,535 word hole is the only one that fits
+    uint16_t holeList[] = { 2, 0, 100, 200, 65535 };
+    if (score == 1 && bestFit(1000, holeList) != 200) {
+        std::cout << "[INCORRECT] bestFit skipped the 65,535 word hole\n" << std::endl;
+        score = 0;
+    }
+
+    engineManager.shutdown();
+    memoryManager.shutdown();
+
     return score;
 }
 
 
-unsigned int testGetList(MemoryManager& memoryManager, uint16_t correctListLength, std::vector<uint16_t> correctList)
+unsigned int testNextFit()
 {
+    std::cout << "Test Case: Next Fit" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 30;
+    NextFitEngine nextFitEngine;
+    MemoryManager memoryManager(wordSize, &nextFitEngine);
+    memoryManager.initialize(numberOfWords);
+
+    uint64_t* testArray1 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 5));
+    uint64_t* testArray2 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 5));
+    memoryManager.allocate(sizeof(uint64_t) * 5);
+
+    memoryManager.free(testArray1);
+
+    // resumes after the third block instead of reusing the hole at offset 0
+    memoryManager.allocate(sizeof(uint64_t) * 5);
+
+    std::vector<uint16_t> correctListAfter1 = { 0, 5, 20, 10 };
+    uint16_t correctListLengthAfter1 = correctListAfter1.size() * 2;
+
     unsigned int score = 0;
-    std::cout << std::dec << std::endl;
-    uint16_t* list = static_cast<uint16_t*>(memoryManager.getList());
-    uint16_t* listEntryPoint = list;
+    score += testGetList(memoryManager, correctListLengthAfter1, correctListAfter1);
 
-    //Dereferences list[0] to get number of holes, then increments to go to list[1]
-    uint16_t listLength = *list++;
+    // the cursor reaches the end of the heap, so the next search wraps around to offset 0
+    memoryManager.allocate(sizeof(uint64_t) * 10);
+    memoryManager.free(testArray2);
+    memoryManager.allocate(sizeof(uint64_t) * 8);
 
-    //2 Bytes for every piece of info (# of holes, offset, size of holes)
-    uint16_t bytesPerEntry = 2;
-    uint16_t entriesInList = listLength * bytesPerEntry;
+    std::vector<uint16_t> correctListAfter2 = { 8, 2 };
+    uint16_t correctListLengthAfter2 = correctListAfter2.size() * 2;
 
-    std::cout << "Testing getList" << std::endl;
-    std::cout << "Expected: " << std::endl;
-    std::cout << std::dec << "[" << correctList[0];
-    for (uint16_t i = 1; i < correctList.size(); ++i) {
-        std::cout << "] - [" << correctList[i];
-    }
-    std::cout << "]" << std::endl;
+    score += testGetList(memoryManager, correctListLengthAfter2, correctListAfter2);
 
+    memoryManager.shutdown();
 
-    std::cout << "\n";
-    std::cout << "Got:" << std::endl;
-    std::cout << std::dec << "[" << list[0];
-    for (uint16_t i = 1; i < entriesInList; ++i) {
-        std::cout << "] - [" << list[i];
-    }
-    std::cout << "]" << std::endl;
+    return score;
+}
 
-    for (uint16_t i = 0; i < entriesInList; ++i) {
-        if (list[i] != correctList[i]) {
-            delete[] listEntryPoint;
-            std::cout << "[INCORRECT]\n" << std::endl;
-            return score;
-        }
-    }
 
-    ++score;
+unsigned int testTlsf()
+{
+    std::cout << "Test Case: TLSF" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 26;
+    TlsfEngine tlsfEngine;
+    MemoryManager memoryManager(wordSize, &tlsfEngine);
+    memoryManager.initialize(numberOfWords);
+
+    uint64_t* testArray1 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 10));
+    memoryManager.allocate(sizeof(uint64_t) * 2);
+    uint64_t* testArray3 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 2));
+    memoryManager.allocate(sizeof(uint64_t) * 6);
+
+    memoryManager.free(testArray1);
+    memoryManager.free(testArray3);
+
+    std::vector<uint8_t> correctBitmap{ 0x00,0xCC,0x0F,0x00 };
+
+    std::vector<uint16_t> correctList = { 0, 10, 12, 2, 20, 6 };
+    uint16_t correctListLength = correctList.size() * 2;
+
+    unsigned int score = 0;
+    score += testGetBitmap(memoryManager, correctBitmap.size(), correctBitmap);
+    score += testGetList(memoryManager, correctListLength, correctList);
+
+    // the 2 word hole is the only hole in the size class for 2 words
+    memoryManager.allocate(sizeof(uint64_t) * 2);
+
+    std::vector<uint16_t> correctListAfter1 = { 0, 10, 20, 6 };
+    uint16_t correctListLengthAfter1 = correctListAfter1.size() * 2;
+
+    score += testGetList(memoryManager, correctListLengthAfter1, correctListAfter1);
+
+    memoryManager.shutdown();
 
-    delete[] listEntryPoint;
-    std::cout << "[CORRECT]\n" << std::endl;
     return score;
 }
 
-unsigned int testGetWordSize(MemoryManager& memoryManager, size_t correctWordSize)
+
+unsigned int testBuddy()
 {
-    std::cout << "Testing getWordSize" << std::endl;
-    std::cout << "Expected: " << correctWordSize << std::endl;
-    std::cout << "Got:" << memoryManager.getWordSize() << std::endl;
-    if (memoryManager.getWordSize() == correctWordSize) {
+    std::cout << "Test Case: Buddy" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 32;
+    BuddyMemory buddyMemory;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.setBackend(&buddyMemory);
+    memoryManager.initialize(numberOfWords);
+
+    // 3 words are rounded up to a block of 4
+    uint64_t* testArray1 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 3));
+    uint64_t* testArray2 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 8));
+    uint64_t* testArray3 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 4));
+
+    std::vector<uint8_t> correctBitmap{ 0xFF, 0xFF, 0x00, 0x00 };
+
+    unsigned int score = 0;
+    score += testGetBitmap(memoryManager, correctBitmap.size(), correctBitmap);
+
+    std::cout << "Testing getInternalFragmentation" << std::endl;
+    std::cout << "Expected: " << 8 << std::endl;
+    std::cout << "Got:" << memoryManager.getInternalFragmentation() << std::endl;
+    if (memoryManager.getInternalFragmentation() == 8) {
         std::cout << "[CORRECT]\n" << std::endl;
-        return 1;
+        ++score;
     }
     else {
         std::cout << "[INCORRECT]\n" << std::endl;
-        return 0;
     }
+
+    // the buddy of testArray1 is still allocated, so it is not merged
+    memoryManager.free(testArray1);
+
+    std::vector<uint16_t> correctListAfterFree1 = { 0, 4, 16, 16 };
+    uint16_t correctListLengthAfterFree1 = correctListAfterFree1.size() * 2;
+
+    score += testGetList(memoryManager, correctListLengthAfterFree1, correctListAfterFree1);
+
+    // merging up through every order gives back the whole heap
+    memoryManager.free(testArray3);
+    memoryManager.free(testArray2);
+
+    std::vector<uint16_t> correctListAfterFree2 = { 0, 32 };
+    uint16_t correctListLengthAfterFree2 = correctListAfterFree2.size() * 2;
+
+    score += testGetList(memoryManager, correctListLengthAfterFree2, correctListAfterFree2);
+
+    memoryManager.shutdown();
+
+    return score;
 }
 
-unsigned int testGetMemoryLimit(MemoryManager& memoryManager, size_t correctMemoryLimit)
+
+unsigned int testBitmapBackend()
 {
-    std::cout << "Testing getMemoryLimit" << std::endl;
-    std::cout << "Expected: " << correctMemoryLimit << std::endl;
-    std::cout << "Got:" << memoryManager.getMemoryLimit() << std::endl;
-    if (memoryManager.getMemoryLimit() == correctMemoryLimit) {
-        std::cout << "[CORRECT]\n" << std::endl;
-        return 1;
-    }
-    else {
-        std::cout << "[INCORRECT]\n" << std::endl;
-        return 0;
+    std::cout << "Test Case: Bitmap backend" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 100;
+    BitmapMemory bitmapMemory;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.setBackend(&bitmapMemory);
+    memoryManager.initialize(numberOfWords);
+
+    uint64_t* testArray1 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 10));
+    uint64_t* testArray2 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 20));
+    uint64_t* testArray3 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 5));
+
+    memoryManager.free(testArray2);
+
+    std::vector<uint16_t> correctListAfterFree = { 10, 20, 35, 65 };
+    uint16_t correctListLengthAfterFree = correctListAfterFree.size() * 2;
+
+    unsigned int score = 0;
+    score += testGetList(memoryManager, correctListLengthAfterFree, correctListAfterFree);
+
+    // the first run of free words that fits is used
+    uint64_t* testArray4 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 15));
+
+    std::vector<uint16_t> correctListAfterAllocate = { 25, 5, 35, 65 };
+    uint16_t correctListLengthAfterAllocate = correctListAfterAllocate.size() * 2;
+
+    score += testGetList(memoryManager, correctListLengthAfterAllocate, correctListAfterAllocate);
+
+    // the bits past the 100th word are not part of the bitmap
+    std::vector<uint8_t> correctBitmap{ 0xFF, 0xFF, 0xFF, 0xC1, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    score += testGetBitmap(memoryManager, correctBitmap.size(), correctBitmap);
+    // testGetBitmap leaves the stream printing in hex
+    std::cout << std::dec;
+
+    memoryManager.free(testArray1);
+    memoryManager.free(testArray3);
+    memoryManager.free(testArray4);
+    memoryManager.shutdown();
+
+    return score;
+}
+
+
+unsigned int testSlabCache()
+{
+    std::cout << "Test Case: Slab cache" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 64;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
+
+    // 2 word objects, 4 objects in each 8 word slab
+    SlabCache slabCache(memoryManager, sizeof(uint64_t) * 2, 4);
+    std::vector<void*> objects;
+    for (unsigned int i = 0; i < 5; ++i) {
+        objects.push_back(slabCache.allocate());
+    }
+
+    std::vector<uint16_t> correctListAfterAllocate = { 16, 48 };
+    uint16_t correctListLengthAfterAllocate = correctListAfterAllocate.size() * 2;
+
+    unsigned int score = 0;
+    score += testGetList(memoryManager, correctListLengthAfterAllocate, correctListAfterAllocate);
+
+    // the second slab is empty, so it goes back to the manager
+    slabCache.free(objects[4]);
+
+    std::vector<uint16_t> correctListAfterFree1 = { 8, 56 };
+    uint16_t correctListLengthAfterFree1 = correctListAfterFree1.size() * 2;
+
+    score += testGetList(memoryManager, correctListLengthAfterFree1, correctListAfterFree1);
+
+    // freed objects are reused before a new slab is allocated
+    slabCache.free(objects[1]);
+    void* reused = slabCache.allocate();
+
+    std::cout << "Testing that a freed object is reused" << std::endl;
+    if (reused == objects[1] && slabCache.getSlabCount() == 1) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        ++score;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    // a second free of the same object is ignored, so the slab is not given back while the reused object is still in use
+    slabCache.free(objects[2]);
+    slabCache.free(objects[2]);
+    slabCache.free(objects[0]);
+    slabCache.free(objects[3]);
+
+    std::cout << "Testing that freeing an object twice is ignored" << std::endl;
+    if (slabCache.getSlabCount() == 1) {
+        score += testGetList(memoryManager, correctListLengthAfterFree1, correctListAfterFree1);
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    slabCache.Clear();
+    memoryManager.shutdown();
+
+    return score;
+}
+
+
+unsigned int testLargeHeap()
+{
+    std::cout << "Test Case: heap larger than 65,536 words" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 200000;
+    MemoryManager memoryManager(wordSize, worstFit);
+    memoryManager.setAllocator32(bestFit32);
+    memoryManager.initialize(numberOfWords);
+
+    uint64_t* testArray1 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 100000));
+    memoryManager.allocate(sizeof(uint64_t) * 70000);
+
+    unsigned int score = 0;
+    score += testGetList32(memoryManager, { 170000, 30000 });
+
+    // 16-bit allocators go through the adapter on large heaps
+    memoryManager.free(testArray1);
+    memoryManager.setAllocator(worstFit);
+    memoryManager.allocate(sizeof(uint64_t) * 1000);
+
+    score += testGetList32(memoryManager, { 1000, 99000, 170000, 30000 });
+
+    uint8_t* bitmap = static_cast<uint8_t*>(memoryManager.getBitmap32());
+    uint32_t bitmapLength = bitmap[0] | (bitmap[1] << 8) | (bitmap[2] << 16) | (bitmap[3] << 24);
+    std::cout << "Testing getBitmap32 length" << std::endl;
+    std::cout << "Expected: " << numberOfWords / 8 << std::endl;
+    std::cout << "Got:" << bitmapLength << std::endl;
+    if (bitmapLength == numberOfWords / 8 && bitmap[4] == 0xFF && bitmap[4 + 124] == 0xFF && bitmap[4 + 125] == 0x00) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        ++score;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+    delete[] bitmap;
+
+    memoryManager.shutdown();
+
+    return score;
+}
+
+unsigned int testAdapterManyHoles()
+{
+    std::cout << "Test Case: 16-bit allocator on a large heap with more than 32,767 holes" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 100000;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
+
+    // freeing every other one-word block leaves 40,001 one-word holes before the free words at the end of the heap
+    std::vector<void*> arrays;
+    for (unsigned int i = 0; i < 80002; ++i) {
+        arrays.push_back(memoryManager.allocate(sizeof(uint64_t)));
+    }
+    for (unsigned int i = 0; i < arrays.size(); i += 2) {
+        memoryManager.free(arrays[i]);
+    }
+
+    // the only hole that fits is past the first 32,767 holes, so bestFit has to see the whole list
+    void* testArray1 = memoryManager.allocate(sizeof(uint64_t) * 100);
+    unsigned int score = 0;
+    std::cout << "Testing bestFit past the first 32,767 holes" << std::endl;
+    if (testArray1 == static_cast<uint64_t*>(memoryManager.getArena()) + 80002) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        ++score;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    // any other allocator cannot be given every hole in a 16-bit list, so the adapter fails instead of leaving holes out
+    memoryManager.free(testArray1);
+    std::function<int(int, void*)> customFirstFit = [](int sizeInWords, void* list) { return firstFit(sizeInWords, list); };
+    Allocator16Adapter adapter(customFirstFit);
+    uint32_t* list = static_cast<uint32_t*>(memoryManager.getList32());
+    int64_t offset = adapter(100, list);
+    delete[] list;
+    memoryManager.setAllocator(customFirstFit);
+    void* testArray2 = memoryManager.allocate(sizeof(uint64_t) * 100);
+    std::cout << "Testing a custom allocator with more than 32,767 holes" << std::endl;
+    if (offset == Allocator16Adapter::TOO_MANY_HOLES && testArray2 == nullptr) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        ++score;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    memoryManager.shutdown();
+
+    return score;
+}
+
+
+unsigned int testEngineMatchesAllocator(std::function<int(int, void*)> allocator, AllocatorEngine* engine, std::string name)
+{
+    std::cout << "Test Case: " << name << " engine picks the same holes as the hole list allocator" << std::endl;
+    unsigned int wordSize = 8;
+    MemoryManager listManager(wordSize, allocator);
+    MemoryManager engineManager(wordSize, engine);
+    return testSameHoles(listManager, engineManager);
+}
+
+unsigned int testHoleViewMatchesAllocator(std::function<int(int, void*)> allocator, std::function<int64_t(uint64_t, const HoleView&)> holeViewAllocator, std::string name)
+{
+    std::cout << "Test Case: " << name << " over the hole view picks the same holes as the hole list allocator" << std::endl;
+    unsigned int wordSize = 8;
+    MemoryManager listManager(wordSize, allocator);
+    MemoryManager viewManager(wordSize, allocator);
+    viewManager.setHoleViewAllocator(holeViewAllocator);
+    return testSameHoles(listManager, viewManager);
+}
+
+unsigned int testPolicyManager()
+{
+    std::cout << "Test Case: Best fit policy picks the same holes as the hole list allocator" << std::endl;
+    unsigned int wordSize = 8;
+    MemoryManager listManager(wordSize, bestFit);
+    PolicyMemoryManager<BestFitEngine> policyManager(wordSize);
+    unsigned int score = testSameHoles(listManager, policyManager);
+
+    // the runtime allocator replaces the policy
+    std::cout << "Test Case: Policy manager with a runtime allocator" << std::endl;
+    MemoryManager worstFitManager(wordSize, worstFit);
+    policyManager.setAllocator(worstFit);
+    score += testSameHoles(worstFitManager, policyManager);
+
+    // code holding a MemoryManager reference, such as a slab cache, allocates through the policy too, and both paths are timed as an allocate
+    std::cout << "Test Case: Policy manager through a MemoryManager reference" << std::endl;
+    policyManager.usePolicy();
+    policyManager.initialize(64);
+    MemoryManager& manager = policyManager;
+    SlabCache slabCache(manager, sizeof(uint64_t) * 2, 4);
+    Instrumentation::reset();
+    void* object = slabCache.allocate();
+    void* testArray1 = policyManager.allocate(sizeof(uint64_t) * 8);
+    Instrumentation::Snapshot snapshot = Instrumentation::snapshot();
+#ifdef MEMORY_INSTRUMENTATION
+    bool timed = snapshot.calls[Instrumentation::ALLOCATE] == 2 && snapshot.calls[Instrumentation::ALLOCATOR_SCAN] == 2;
+#else
+    bool timed = snapshot.calls[Instrumentation::ALLOCATE] == 0;
+#endif
+    Instrumentation::reset();
+    if (object == policyManager.getArena() && testArray1 == static_cast<uint64_t*>(policyManager.getArena()) + 8 && timed) {
+        std::vector<uint16_t> correctList = { 16, 48 };
+        score += testGetList(policyManager, correctList.size() * 2, correctList);
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+    slabCache.Clear();
+    policyManager.shutdown();
+
+    return score;
+}
+
+unsigned int testConcurrentManager()
+{
+    std::cout << "Test Case: Concurrent manager" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 4096;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
+    unsigned int score = 0;
+    {
+        ConcurrentMemoryManager concurrentManager(memoryManager, 8);
+
+        // 3 words are a block of 4, which the thread cache hands out again for any size of that class
+        void* testArray1 = concurrentManager.allocate(sizeof(uint64_t) * 3);
+        concurrentManager.free(testArray1, sizeof(uint64_t) * 3);
+        void* testArray2 = concurrentManager.allocate(sizeof(uint64_t) * 4);
+        std::cout << "Testing the thread cache reuses a freed block" << std::endl;
+        if (testArray1 != nullptr && testArray1 == testArray2) {
+            std::cout << "[CORRECT]\n" << std::endl;
+            ++score;
+        }
+        else {
+            std::cout << "[INCORRECT]\n" << std::endl;
+        }
+        concurrentManager.free(testArray2, sizeof(uint64_t) * 4);
+
+        // every thread gives its cache back when it exits, and the main thread's cache is flushed
+        std::vector<std::thread> threads;
+        for (unsigned int t = 0; t < 4; ++t) {
+            threads.push_back(std::thread([&concurrentManager, t]() {
+                std::vector<std::pair<void*, size_t>> arrays;
+                uint32_t seed = 12345 + t;
+                for (unsigned int i = 0; i < 5000; ++i) {
+                    seed = seed * 1103515245 + 12345;
+                    uint32_t random = seed >> 8;
+                    if (random % 2 == 0 || arrays.empty()) {
+                        size_t bytes = sizeof(uint64_t) * (1 + (random >> 4) % 20);
+                        void* array = concurrentManager.allocate(bytes);
+                        if (array != nullptr) {
+                            arrays.push_back(std::make_pair(array, bytes));
+                        }
+                    }
+                    else {
+                        size_t index = (random >> 4) % arrays.size();
+                        concurrentManager.free(arrays[index].first, arrays[index].second);
+                        arrays.erase(arrays.begin() + index);
+                    }
+                }
+                for (size_t i = 0; i < arrays.size(); ++i) {
+                    concurrentManager.free(arrays[i].first, arrays[i].second);
+                }
+            }));
+        }
+        for (size_t t = 0; t < threads.size(); ++t) {
+            threads[t].join();
+        }
+        concurrentManager.flushThreadCache();
+    }
+
+    std::vector<uint16_t> correctList = { 0, 4096 };
+    uint16_t correctListLength = correctList.size() * 2;
+    score += testGetList(memoryManager, correctListLength, correctList);
+
+    memoryManager.shutdown();
+
+    return score;
+}
+
+unsigned int testShardedManager()
+{
+    std::cout << "Test Case: Sharded manager" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 100;
+    ShardedMemoryManager shardedManager(wordSize, bestFit, 2, ShardedMemoryManager::ROUND_ROBIN);
+    shardedManager.initialize(numberOfWords);
+
+    // each shard holds 50 words, so the second block spills over into the shard the thread was not assigned
+    void* testArray1 = shardedManager.allocate(sizeof(uint64_t) * 50);
+    void* testArray2 = shardedManager.allocate(sizeof(uint64_t) * 50);
+    void* testArray3 = shardedManager.allocate(sizeof(uint64_t) * 1);
+
+    std::vector<uint8_t> correctBitmap{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F };
+    unsigned int score = 0;
+    std::cout << "Testing getBitmap" << std::endl;
+    uint8_t* bitmap = static_cast<uint8_t*>(shardedManager.getBitmap());
+    bool correct = testArray1 != nullptr && testArray2 != nullptr && testArray3 == nullptr;
+    correct = correct && bitmap[0] == correctBitmap.size() && bitmap[1] == 0;
+    for (size_t i = 0; correct && i < correctBitmap.size(); ++i) {
+        correct = bitmap[2 + i] == correctBitmap[i];
+    }
+    delete[] bitmap;
+    if (correct) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        ++score;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    // the holes at either side of the shard boundary are in different arenas
+    shardedManager.free(testArray1);
+    shardedManager.free(testArray2);
+    std::cout << "Testing getList" << std::endl;
+    uint16_t* list = static_cast<uint16_t*>(shardedManager.getList());
+    std::vector<uint16_t> correctList = { 2, 0, 50, 50, 50 };
+    correct = list != nullptr;
+    for (size_t i = 0; correct && i < correctList.size(); ++i) {
+        correct = list[i] == correctList[i];
+    }
+    delete[] list;
+    if (correct) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        ++score;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    shardedManager.shutdown();
+
+    return score;
+}
+
+unsigned int testShardedBitmap32()
+{
+    std::cout << "Test Case: Sharded manager getBitmap32 across shards that do not start on a byte" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 100;
+    ShardedMemoryManager shardedManager(wordSize, bestFit, 3, ShardedMemoryManager::ROUND_ROBIN);
+    shardedManager.initialize(numberOfWords);
+
+    // the shards hold 34, 33 and 33 words, so every word is allocated once 100 one-word blocks are
+    bool correct = true;
+    for (size_t i = 0; i < numberOfWords; ++i) {
+        correct = correct && shardedManager.allocate(sizeof(uint64_t)) != nullptr;
+    }
+
+    std::vector<uint8_t> correctBitmap{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F };
+    uint8_t* bitmap = static_cast<uint8_t*>(shardedManager.getBitmap32());
+    correct = correct && bitmap[0] == correctBitmap.size() && bitmap[1] == 0 && bitmap[2] == 0 && bitmap[3] == 0;
+    for (size_t i = 0; correct && i < correctBitmap.size(); ++i) {
+        correct = bitmap[4 + i] == correctBitmap[i];
+    }
+    delete[] bitmap;
+
+    shardedManager.shutdown();
+
+    if (correct) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        return 1;
+    }
+    std::cout << "[INCORRECT]\n" << std::endl;
+    return 0;
+}
+
+
+unsigned int testLockFreePool()
+{
+    std::cout << "Test Case: Lock free pool" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 256;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
+    unsigned int score = 0;
+    {
+        LockFreePool pool(memoryManager, 16, 64);
+
+        // every object is handed out once, then the pool is empty
+        std::vector<void*> objects;
+        for (unsigned int i = 0; i < 65; ++i) {
+            objects.push_back(pool.allocate());
+        }
+        std::cout << "Testing the pool runs out after 64 objects" << std::endl;
+        bool correct = objects[63] != nullptr && objects[64] == nullptr && pool.getCounters().exhausted == 1;
+        for (unsigned int i = 0; correct && i < 64; ++i) {
+            correct = objects[i] == static_cast<uint8_t*>(objects[0]) + (i * 16);
+        }
+        if (correct) {
+            std::cout << "[CORRECT]\n" << std::endl;
+            ++score;
+        }
+        else {
+            std::cout << "[INCORRECT]\n" << std::endl;
+        }
+        for (unsigned int i = 0; i < 64; ++i) {
+            pool.free(objects[i]);
+        }
+
+        // threads pop and push concurrently, then every object is in the pool exactly once
+        std::vector<std::thread> threads;
+        for (unsigned int t = 0; t < 4; ++t) {
+            threads.push_back(std::thread([&pool]() {
+                for (unsigned int i = 0; i < 20000; ++i) {
+                    void* object = pool.allocate();
+                    if (object != nullptr) {
+                        *static_cast<uint64_t*>(object) = i;
+                        pool.free(object);
+                    }
+                }
+            }));
+        }
+        for (size_t t = 0; t < threads.size(); ++t) {
+            threads[t].join();
+        }
+        std::set<void*> distinct;
+        void* object = pool.allocate();
+        while (object != nullptr) {
+            distinct.insert(object);
+            object = pool.allocate();
+        }
+        std::cout << "Testing every object is returned once after concurrent use" << std::endl;
+        std::cout << "Expected: " << 64 << std::endl;
+        std::cout << "Got:" << distinct.size() << std::endl;
+        if (distinct.size() == 64) {
+            std::cout << "[CORRECT]\n" << std::endl;
+            ++score;
+        }
+        else {
+            std::cout << "[INCORRECT]\n" << std::endl;
+        }
+    }
+
+    memoryManager.shutdown();
+
+    return score;
+}
+
+unsigned int testTraceReplay()
+{
+    std::cout << "Test Case: Trace replay" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 100;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
+
+    // the last free names an id that was never allocated
+    std::vector<TraceReplay::TraceRecord> records = {
+        { TraceReplay::ALLOCATE, 0, 80, 1 },
+        { TraceReplay::ALLOCATE, 1, 160, 2 },
+        { TraceReplay::FREE, 0, 0, 3 },
+        { TraceReplay::FREE, 5, 0, 4 },
+    };
+    TraceReplay::writeTrace("testTraceReplay.trace", records, true);
+
+    TraceReplay traceReplay(memoryManager);
+    TraceReplay::ReplayReport report;
+    int status = traceReplay.replay("testTraceReplay.trace", report);
+
+    unsigned int score = 0;
+    std::cout << "Testing the replay counts" << std::endl;
+    if (status == 0 && report.records == 4 && report.allocations == 2 && report.failedAllocations == 0 && report.frees == 2 && report.unknownFrees == 1) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        ++score;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    // the holes left are [0, 10] and [30, 70]
+    std::cout << "Testing the final fragmentation" << std::endl;
+    std::cout << "Expected: " << 0.125 << std::endl;
+    std::cout << "Got:" << report.externalFragmentation << std::endl;
+    if (report.holes == 2 && report.freeWords == 80 && report.largestHole == 70 && std::fabs(report.externalFragmentation - 0.125) < 1e-9) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        ++score;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    traceReplay.clear();
+    memoryManager.shutdown();
+
+    return score;
+}
+
+unsigned int testTraceReplaySparseIds()
+{
+    std::cout << "Test Case: Trace replay with ids far past the number of records" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 100;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
+
+    // the last free names a large id that was never allocated
+    std::vector<TraceReplay::TraceRecord> records = {
+        { TraceReplay::ALLOCATE, 0xFFFFFFFF, 80, 0 },
+        { TraceReplay::ALLOCATE, 7000000, 160, 0 },
+        { TraceReplay::FREE, 0xFFFFFFFF, 0, 0 },
+        { TraceReplay::FREE, 12345678, 0, 0 },
+    };
+    TraceReplay::writeTrace("testTraceReplaySparseIds.trace", records, false);
+
+    TraceReplay traceReplay(memoryManager);
+    TraceReplay::ReplayReport report;
+    int status = traceReplay.replay("testTraceReplaySparseIds.trace", report);
+    traceReplay.clear();
+
+    unsigned int score = 0;
+    if (status == 0 && report.allocations == 2 && report.sparseIds == 2 && report.unknownFrees == 1 && report.holes == 2 &&
+        memoryManager.getStats().freeWords == numberOfWords) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        score = 1;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    memoryManager.shutdown();
+
+    return score;
+}
+
+
+unsigned int testStats()
+{
+    std::cout << "Test Case: getStats matches the hole list" << std::endl;
+    unsigned int wordSize = 8;
+    MemoryManager listManager(wordSize, bestFit);
+    unsigned int score = testStatsWorkload(listManager);
+
+    // the counters start over with the next heap
+    TlsfEngine tlsfEngine;
+    MemoryManager engineManager(wordSize, &tlsfEngine);
+    if (testStatsWorkload(engineManager) == 1) {
+        engineManager.initialize(500);
+        MemoryManager::Stats stats = engineManager.getStats();
+        if (stats.freeWords == 500 && stats.holes == 1 && stats.largestHole == 500 && stats.externalFragmentation == 0) {
+            std::cout << "[CORRECT]\n" << std::endl;
+            ++score;
+        }
+        else {
+            std::cout << "[INCORRECT]\n" << std::endl;
+        }
+        engineManager.shutdown();
+    }
+
+    return score;
+}
+
+unsigned int testInstrumentation()
+{
+    std::cout << "Test Case: Instrumentation counts the calling thread's allocates and frees" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 20;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
+
+    Instrumentation::reset();
+    void* testArray1 = memoryManager.allocate(sizeof(uint64_t) * 5);
+    void* testArray2 = memoryManager.allocate(sizeof(uint64_t) * 5);
+    memoryManager.allocate(sizeof(uint64_t) * 5);
+    memoryManager.free(testArray1);
+    memoryManager.free(testArray2);
+    Instrumentation::Snapshot snapshot = Instrumentation::snapshot();
+
+    uint64_t histogramCalls = 0;
+    for (unsigned int bucket = 0; bucket < Instrumentation::BUCKETS; ++bucket) {
+        histogramCalls += snapshot.histograms[Instrumentation::ALLOCATE][bucket];
+    }
+
+    // without MEMORY_INSTRUMENTATION nothing is recorded
+#ifdef MEMORY_INSTRUMENTATION
+    bool correct = snapshot.calls[Instrumentation::ALLOCATE] == 3 && snapshot.calls[Instrumentation::FREE] == 2 && histogramCalls == 3 &&
+        snapshot.calls[Instrumentation::HOLE_LIST_BUILD] == 3 && snapshot.counters[Instrumentation::LIST_NODES_VISITED] == 3 &&
+        snapshot.counters[Instrumentation::COALESCES] == 1;
+#else
+    bool correct = snapshot.calls[Instrumentation::ALLOCATE] == 0 && snapshot.calls[Instrumentation::FREE] == 0 && histogramCalls == 0 &&
+        snapshot.counters[Instrumentation::COALESCES] == 0;
+#endif
+
+    memoryManager.shutdown();
+    Instrumentation::reset();
+
+    if (correct) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        return 1;
+    }
+    std::cout << "[INCORRECT]\n" << std::endl;
+    return 0;
+}
+
+unsigned int testReallocate()
+{
+    std::cout << "Test Case: reallocate grows and shrinks in place, and moves otherwise" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 20;
+    MemoryManager memoryManager(wordSize, bestFit);
+    memoryManager.initialize(numberOfWords);
+
+    uint64_t* testArray1 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 5));
+    uint64_t* testArray2 = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * 5));
+
+    // testArray2 grows into the hole after it
+    unsigned int score = 0;
+    if (memoryManager.reallocate(testArray2, sizeof(uint64_t) * 8) == testArray2) {
+        std::vector<uint16_t> correctList = { 13, 7 };
+        score += testGetList(memoryManager, correctList.size() * 2, correctList);
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    // testArray1 gives its tail back as a new hole
+    if (memoryManager.reallocate(testArray1, sizeof(uint64_t) * 2) == testArray1) {
+        std::vector<uint16_t> correctList = { 2, 3, 13, 7 };
+        score += testGetList(memoryManager, correctList.size() * 2, correctList);
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    // testArray2 is after testArray1, so growing testArray1 moves it into the best fit and frees the old block
+    testArray1[0] = 11;
+    testArray1[1] = 22;
+    uint64_t* testArray3 = static_cast<uint64_t*>(memoryManager.reallocate(testArray1, sizeof(uint64_t) * 6));
+    if (testArray3 == static_cast<uint64_t*>(memoryManager.getArena()) + 13 && testArray3[0] == 11 && testArray3[1] == 22) {
+        std::vector<uint16_t> correctList = { 0, 5, 19, 1 };
+        score += testGetList(memoryManager, correctList.size() * 2, correctList);
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    memoryManager.shutdown();
+
+    return score;
+}
+
+
+unsigned int testZeroSizeAllocate()
+{
+    std::cout << "Test Case: allocations smaller than a word" << std::endl;
+    unsigned int wordSize = 8;
+    size_t numberOfWords = 10;
+    MemoryManager memoryManager(wordSize, worstFit);
+    memoryManager.initialize(numberOfWords);
+
+    // requests that round to 0 words get 1 word, so every block has its own offset
+    uint64_t* arena = static_cast<uint64_t*>(memoryManager.getArena());
+    void* testArray1 = memoryManager.allocate(0);
+    void* testArray2 = memoryManager.allocate(4);
+    void* testArray3 = memoryManager.allocate(sizeof(uint64_t) * 7);
+
+    unsigned int score = 0;
+    if (testArray1 == arena && testArray2 == arena + 1 && testArray3 == arena + 2) {
+        std::vector<uint16_t> correctList = { 9, 1 };
+        score += testGetList(memoryManager, correctList.size() * 2, correctList);
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    memoryManager.free(testArray1);
+    memoryManager.free(testArray2);
+    memoryManager.free(testArray3);
+
+    MemoryManager::Stats stats = memoryManager.getStats();
+    std::cout << "Testing getStats after freeing every block" << std::endl;
+    std::cout << "Expected: 10 free words in 1 hole" << std::endl;
+    std::cout << "Got: " << stats.freeWords << " free words in " << stats.holes << " hole(s)" << std::endl;
+    std::vector<uint16_t> correctList = { 0, 10 };
+    if (stats.freeWords == 10 && stats.holes == 1 && stats.largestHole == 10) {
+        score += testGetList(memoryManager, correctList.size() * 2, correctList);
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+    }
+
+    memoryManager.shutdown();
+
+    return score;
+}
+
+
+// runs the same allocations and frees on both managers, which must have the same holes after every operation
+// rhs is a template so a PolicyMemoryManager is called through its own allocate()
+template <class Manager>
+unsigned int testSameHoles(MemoryManager& lhs, Manager& rhs)
+{
+    size_t numberOfWords = 1000;
+    lhs.initialize(numberOfWords);
+    rhs.initialize(numberOfWords);
+
+    std::vector<uint64_t*> lhsArrays;
+    std::vector<uint64_t*> rhsArrays;
+    uint32_t seed = 12345;
+
+    for (unsigned int i = 0; i < 2000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t random = seed >> 8;
+        if (random % 3 != 0 || lhsArrays.empty()) {
+            size_t words = 1 + (random >> 4) % 40;
+            uint64_t* lhsArray = static_cast<uint64_t*>(lhs.allocate(sizeof(uint64_t) * words));
+            uint64_t* rhsArray = static_cast<uint64_t*>(rhs.allocate(sizeof(uint64_t) * words));
+            if ((lhsArray == nullptr) != (rhsArray == nullptr)) {
+                std::cout << "[INCORRECT]\n" << std::endl;
+                return 0;
+            }
+            if (lhsArray != nullptr) {
+                lhsArrays.push_back(lhsArray);
+                rhsArrays.push_back(rhsArray);
+            }
+        }
+        else {
+            size_t index = (random >> 4) % lhsArrays.size();
+            lhs.free(lhsArrays[index]);
+            rhs.free(rhsArrays[index]);
+            lhsArrays.erase(lhsArrays.begin() + index);
+            rhsArrays.erase(rhsArrays.begin() + index);
+        }
+
+        if (!sameHoleList(lhs, rhs)) {
+            std::cout << "Hole lists differ after operation " << i << std::endl;
+            std::cout << "[INCORRECT]\n" << std::endl;
+            return 0;
+        }
+    }
+
+    lhs.shutdown();
+    rhs.shutdown();
+    std::cout << "[CORRECT]\n" << std::endl;
+    return 1;
+}
+
+
+unsigned int testStatsWorkload(MemoryManager& memoryManager)
+{
+    size_t numberOfWords = 1000;
+    memoryManager.initialize(numberOfWords);
+
+    std::vector<uint64_t*> arrays;
+    uint32_t seed = 54321;
+
+    for (unsigned int i = 0; i < 2000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t random = seed >> 8;
+        if (random % 3 != 0 || arrays.empty()) {
+            size_t words = 1 + (random >> 4) % 40;
+            uint64_t* array = static_cast<uint64_t*>(memoryManager.allocate(sizeof(uint64_t) * words));
+            if (array != nullptr) {
+                arrays.push_back(array);
+            }
+        }
+        else {
+            size_t index = (random >> 4) % arrays.size();
+            memoryManager.free(arrays[index]);
+            arrays.erase(arrays.begin() + index);
+        }
+
+        uint64_t freeWords = 0;
+        uint64_t largestHole = 0;
+        uint64_t holes = 0;
+        uint32_t* list = static_cast<uint32_t*>(memoryManager.getList32());
+        if (list != nullptr) {
+            holes = list[0];
+            for (uint32_t j = 0; j < list[0]; ++j) {
+                freeWords += list[(j * 2) + 2];
+                largestHole = std::max<uint64_t>(largestHole, list[(j * 2) + 2]);
+            }
+        }
+        delete[] list;
+
+        MemoryManager::Stats stats = memoryManager.getStats();
+        if (stats.freeWords != freeWords || stats.holes != holes || stats.largestHole != largestHole) {
+            std::cout << "Stats differ from the hole list after operation " << i << std::endl;
+            std::cout << "[INCORRECT]\n" << std::endl;
+            memoryManager.shutdown();
+            return 0;
+        }
+    }
+
+    memoryManager.shutdown();
+    std::cout << "[CORRECT]\n" << std::endl;
+    return 1;
+}
+
+
+std::string vectorToString(const std::vector<uint16_t>& vector)
+{
+    std::string vectorString = "";
+
+    vectorString += "[" + std::to_string(vector[0]) + ", " + std::to_string(vector[1]);
+    for (int i = 2; i < vector.size(); i += 2)
+    {
+        vectorString += "] - [" + std::to_string(vector[i]) + ", " + std::to_string(vector[i + 1]);
+    }
+    vectorString += "]";
+
+    return vectorString;
+}
+
+
+unsigned int testGetBitmap(MemoryManager& memoryManager, uint16_t correctBitmapLength, std::vector<uint8_t> correctBitmap)
+{
+    unsigned int score = 0;
+    uint8_t* bitmap = static_cast<uint8_t*>(memoryManager.getBitmap());
+    uint8_t* bitmapEntryPoint = bitmap;
+
+    uint8_t lowerByte = *bitmap++;
+    uint8_t higherByte = *bitmap++;
+    uint16_t byteStreamLength = (higherByte << 8) | lowerByte;
+
+    std::cout << "Testing getBitmap" << std::endl;
+    std::cout << "Expected: " << std::endl;
+    std::cout << "[0x" << std::hex << (int)correctBitmap[0];
+
+    for (uint16_t i = 1; i < correctBitmap.size(); ++i) {
+        std::cout << ", 0x" << std::hex << (int)correctBitmap[i];
+    }
+    std::cout << "]" << std::endl;
+
+
+    std::cout << "\n";
+    std::cout << "Got:" << std::endl;
+    std::cout << "[0x" << std::hex << (int)bitmap[0];
+    for (uint16_t i = 1; i < byteStreamLength; ++i) {
+        std::cout << ", 0x" << std::hex << (int)bitmap[i];
+    }
+    std::cout << "]" << std::endl;
+
+    for (uint16_t i = 0; i < byteStreamLength; ++i) {
+        if (bitmap[i] != correctBitmap[i]) {
+            delete[] bitmapEntryPoint;
+            std::cout << "[INCORRECT]\n" << std::endl;
+            return score;
+        }
+    }
+
+    ++score;
+    delete[] bitmapEntryPoint;
+    std::cout << "[CORRECT]\n" << std::endl;
+    return score;
+}
+
+
+unsigned int testGetList(MemoryManager& memoryManager, uint16_t correctListLength, std::vector<uint16_t> correctList)
+{
+    unsigned int score = 0;
+    std::cout << std::dec << std::endl;
+    uint16_t* list = static_cast<uint16_t*>(memoryManager.getList());
+    uint16_t* listEntryPoint = list;
+
+    //Dereferences list[0] to get number of holes, then increments to go to list[1]
+    uint16_t listLength = *list++;
+
+    //2 Bytes for every piece of info (# of holes, offset, size of holes)
+    uint16_t bytesPerEntry = 2;
+    uint16_t entriesInList = listLength * bytesPerEntry;
+
+    std::cout << "Testing getList" << std::endl;
+    std::cout << "Expected: " << std::endl;
+    std::cout << std::dec << "[" << correctList[0];
+    for (uint16_t i = 1; i < correctList.size(); ++i) {
+        std::cout << "] - [" << correctList[i];
+    }
+    std::cout << "]" << std::endl;
+
+
+    std::cout << "\n";
+    std::cout << "Got:" << std::endl;
+    std::cout << std::dec << "[" << list[0];
+    for (uint16_t i = 1; i < entriesInList; ++i) {
+        std::cout << "] - [" << list[i];
+    }
+    std::cout << "]" << std::endl;
+
+    for (uint16_t i = 0; i < entriesInList; ++i) {
+        if (list[i] != correctList[i]) {
+            delete[] listEntryPoint;
+            std::cout << "[INCORRECT]\n" << std::endl;
+            return score;
+        }
+    }
+
+    ++score;
+
+    delete[] listEntryPoint;
+    std::cout << "[CORRECT]\n" << std::endl;
+    return score;
+}
+
+unsigned int testGetList32(MemoryManager& memoryManager, std::vector<uint32_t> correctList)
+{
+    std::cout << "Testing getList32" << std::endl;
+    uint32_t* list = static_cast<uint32_t*>(memoryManager.getList32());
+    bool correct = list != nullptr && list[0] * 2 == correctList.size();
+    for (uint32_t i = 0; correct && i < correctList.size(); ++i) {
+        correct = list[i + 1] == correctList[i];
+    }
+    delete[] list;
+    if (correct) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        return 1;
+    }
+    std::cout << "[INCORRECT]\n" << std::endl;
+    return 0;
+}
+
+unsigned int testGetWordSize(MemoryManager& memoryManager, size_t correctWordSize)
+{
+    std::cout << "Testing getWordSize" << std::endl;
+    std::cout << "Expected: " << correctWordSize << std::endl;
+    std::cout << "Got:" << memoryManager.getWordSize() << std::endl;
+    if (memoryManager.getWordSize() == correctWordSize) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        return 1;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+        return 0;
+    }
+}
+
+unsigned int testGetMemoryLimit(MemoryManager& memoryManager, size_t correctMemoryLimit)
+{
+    std::cout << "Testing getMemoryLimit" << std::endl;
+    std::cout << "Expected: " << correctMemoryLimit << std::endl;
+    std::cout << "Got:" << memoryManager.getMemoryLimit() << std::endl;
+    if (memoryManager.getMemoryLimit() == correctMemoryLimit) {
+        std::cout << "[CORRECT]\n" << std::endl;
+        return 1;
+    }
+    else {
+        std::cout << "[INCORRECT]\n" << std::endl;
+        return 0;
+    }
+}
+
+bool sameHoleList(MemoryManager& lhs, MemoryManager& rhs)
+{
+    uint16_t* lhsList = static_cast<uint16_t*>(lhs.getList());
+    uint16_t* rhsList = static_cast<uint16_t*>(rhs.getList());
+    bool same = (lhsList == nullptr) == (rhsList == nullptr);
+    if (same && lhsList != nullptr) {
+        same = lhsList[0] == rhsList[0];
+        for (uint16_t i = 1; same && i <= lhsList[0] * 2; ++i) {
+            same = lhsList[i] == rhsList[i];
+        }
     }
+    delete[] lhsList;
+    delete[] rhsList;
+    return same;
 }
 
 unsigned int testDumpMemoryMap(MemoryManager& memoryManager, std::string fileName, std::string correctFileContents)